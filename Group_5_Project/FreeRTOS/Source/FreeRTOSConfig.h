@@ -38,7 +38,17 @@
  * FreeRTOS API DOCUMENTATION AVAILABLE ON THE FreeRTOS.org WEB SITE.
  *----------------------------------------------------------*/
 
-#include <project.h> // Keep this for PSoC Creator specific defines if needed elsewhere
+#include <stdint.h>
+
+/* This file is included by every kernel source, so it pulls in no
+application headers: the hooks the macros below call are declared
+here with plain types (uint8 and uint32 in the application). */
+extern void     stats_runtime_init( void );
+extern uint32_t stats_runtime( void );
+extern uint8_t  power_may_sleep( void );
+extern void     power_pre_sleep( uint32_t ulIdleTicks );
+extern void     power_post_sleep( void );
+extern void     vPortSuppressTicksAndSleep( uint32_t xExpectedIdleTime );   /* TickType_t */
 
 //#define SYSTEM_SUPPORT_OS         1 // This line is commented out, which is fine
 
@@ -57,12 +67,11 @@
 
 
 #define configTICK_RATE_HZ          ( ( TickType_t ) 1000 )
-// Increased minimal stack size. 100 words (400 bytes) is often too small.
-// Using 256 words (1KB) for Cortex-M3 is a safer starting point.
-#define configMINIMAL_STACK_SIZE    ( ( unsigned short ) 256 ) // <--- INCREASED STACK SIZE
-#define configTOTAL_HEAP_SIZE       ( ( size_t ) ( 32 * 1024 ) )
+// Only the idle task uses this; it does no more than enter sleep.
+// STATS reports its free stack words.
+#define configMINIMAL_STACK_SIZE    ( ( unsigned short ) 128 )
 #define configMAX_TASK_NAME_LEN     ( 12 )
-#define configUSE_TRACE_FACILITY    0
+#define configUSE_TRACE_FACILITY    1   // uxTaskGetSystemState for STATS
 #define configUSE_16_BIT_TICKS      0
 #define configIDLE_SHOULD_YIELD     0
 #define configUSE_CO_ROUTINES       0
@@ -75,8 +84,29 @@
 #define configCHECK_FOR_STACK_OVERFLOW  2   // Changed to 2 for stack overflow detection during development
 #define configUSE_RECURSIVE_MUTEXES     1
 #define configQUEUE_REGISTRY_SIZE       10
-#define configGENERATE_RUN_TIME_STATS   0
-#define configUSE_MALLOC_FAILED_HOOK    1   // Changed to 1 to catch malloc failures (e.g., heap exhaustion)
+#define configGENERATE_RUN_TIME_STATS   1
+
+/* Run-time stats clock for STATS: DWT cycles / 256, see stats.c. DWT
+stops in Alternate Active, so task shares are of awake time. */
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    stats_runtime_init()
+#define portGET_RUN_TIME_COUNTER_VALUE()            stats_runtime()
+#define configUSE_MALLOC_FAILED_HOOK    0
+
+/* Every kernel object is static (tasks, queues, stream and message
+buffers), so there is no FreeRTOS heap and heap_1.c is not built. The
+SRAM it held is the scope's capture memory; Python_Scripts/mem_report.py
+prints the budget from the map file. */
+#define configSUPPORT_STATIC_ALLOCATION     1
+#define configSUPPORT_DYNAMIC_ALLOCATION    0
+
+/* Tickless idle, see power.c. EXPECTED_IDLE_TIME is the shortest idle
+period (ticks) worth reprogramming SysTick for; the wake budget is
+POWER_WAKE_LATENCY_CYC in power.h. */
+#define configUSE_TICKLESS_IDLE                 1
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP   2
+#define portSUPPRESS_TICKS_AND_SLEEP( x )       do { if( power_may_sleep() ) vPortSuppressTicksAndSleep( x ); } while( 0 )
+#define configPRE_SLEEP_PROCESSING( x )         power_pre_sleep( x )
+#define configPOST_SLEEP_PROCESSING( x )        power_post_sleep()
 
 /* Set the following definitions to 1 to include the API function, or zero
 to exclude the API function. */
@@ -0,0 +1,15 @@
+#ifndef HOST_FREERTOS_CONFIG_H
+#define HOST_FREERTOS_CONFIG_H
+
+/* The firmware's own configuration, so the kernel is built the same
+ * way as on the PSoC, plus what the host port needs on top. */
+#include "../../FreeRTOS/Source/FreeRTOSConfig.h"
+
+/* the idle task is where virtual time passes (port.c) */
+#undef  configUSE_IDLE_HOOK
+#define configUSE_IDLE_HOOK         1
+
+void sim_assert_failed(const char *file, int line);
+#define configASSERT( x )           do { if( !( x ) ) sim_assert_failed( __FILE__, __LINE__ ); } while( 0 )
+
+#endif /* HOST_FREERTOS_CONFIG_H */
@@ -0,0 +1,285 @@
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "project.h"
+#include "sim.h"
+
+/* pthreads only need room for the task code itself: the FreeRTOS stack
+ * array holds nothing but the thread handle */
+#define PORT_THREAD_STACK  (1024u * 1024u)
+
+#define PORT_TICK_CYC      ((uint64_t)SIM_HZ / configTICK_RATE_HZ)
+
+/* a sleep is one SysTick reload, 24 bits of CPU cycles */
+#define PORT_MAX_IDLE      ((TickType_t)(0xFFFFFFu / PORT_TICK_CYC))
+#define PORT_TICK_PRIO     (configKERNEL_INTERRUPT_PRIORITY >> (8 - configPRIO_BITS))
+
+typedef struct
+{
+    pthread_t      id;
+    sem_t          run;
+    TaskFunction_t code;
+    void          *param;
+} port_thread_t;
+
+void xPortSysTickHandler(void);
+
+/* tasks.c: the first member of a TCB is pxTopOfStack */
+extern void * volatile pxCurrentTCB;
+
+static UBaseType_t    criticalNesting = 0xaaaaaaaau;
+static uint8_t        started;
+static uint8_t        switchPending;
+static uint8_t        slept;
+static __thread port_thread_t *self;
+
+static port_thread_t *thread_of(void *tcb)
+{
+    return (port_thread_t *)**(StackType_t **)tcb;
+}
+
+static void wait_turn(port_thread_t *t)
+{
+    while (sem_wait(&t->run) != 0)
+    {
+    }
+}
+
+static void *task_main(void *arg)
+{
+    port_thread_t *t = arg;
+
+    self = t;
+    wait_turn(t);
+    t->code(t->param);
+    fprintf(stderr, "sim: a task function returned\n");
+    exit(2);
+}
+
+/* pick the next task and hand the CPU to its thread */
+static void do_switch(void)
+{
+    port_thread_t *from = self;
+    port_thread_t *to;
+
+    vTaskSwitchContext();
+    to = thread_of(pxCurrentTCB);
+    if (to == from)
+        return;
+    sem_post(&to->run);
+    wait_turn(from);
+}
+
+static uint8_t may_switch(void)
+{
+    return started && (self != NULL) && (criticalNesting == 0u) &&
+           !simPrimask && (simBasepri == 0u) && (sim_active_irq() == 0u);
+}
+
+/* =========================================================
+ *  portable.h
+ * =======================================================*/
+StackType_t *pxPortInitialiseStack(StackType_t *pxTopOfStack, TaskFunction_t pxCode,
+                                   void *pvParameters)
+{
+    port_thread_t *t = calloc(1u, sizeof(*t));
+    pthread_attr_t attr;
+
+    if (t == NULL)
+    {
+        fprintf(stderr, "sim: out of memory for a task thread\n");
+        exit(2);
+    }
+    sem_init(&t->run, 0, 0u);
+    t->code  = pxCode;
+    t->param = pvParameters;
+
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, PORT_THREAD_STACK);
+    if (pthread_create(&t->id, &attr, task_main, t) != 0)
+    {
+        fprintf(stderr, "sim: cannot start a task thread\n");
+        exit(2);
+    }
+    pthread_attr_destroy(&attr);
+
+    *pxTopOfStack = (StackType_t)(uintptr_t)t;
+    return pxTopOfStack;
+}
+
+BaseType_t xPortStartScheduler(void)
+{
+    sim_irq_t *st = &simIrq[SIM_IRQ_SYSTICK];
+
+    if (st->vector == NULL)
+        st->vector = xPortSysTickHandler;
+    st->prio    = PORT_TICK_PRIO;
+    st->enabled = 1u;
+    sim_schedule(SIM_IRQ_SYSTICK, simNow + PORT_TICK_CYC, PORT_TICK_CYC);
+
+    criticalNesting = 0u;
+    simBasepri      = 0u;
+    started         = 1u;
+    sem_post(&thread_of(pxCurrentTCB)->run);
+
+    /* the main thread is done: sim_finish() ends the process */
+    for (;;)
+        pause();
+    return pdFALSE;
+}
+
+void vPortEndScheduler(void)
+{
+}
+
+/* =========================================================
+ *  portmacro.h
+ * =======================================================*/
+void vPortYield(void)
+{
+    if (!may_switch())
+    {
+        /* like PendSV: taken once the masks drop */
+        switchPending = 1u;
+        return;
+    }
+    switchPending = 0u;
+    do_switch();
+}
+
+void vPortYieldFromISR(void)
+{
+    switchPending = 1u;
+}
+
+void vPortSwitchIfPending(void)
+{
+    if (switchPending && may_switch())
+    {
+        switchPending = 0u;
+        do_switch();
+    }
+}
+
+void vPortEnterCritical(void)
+{
+    (void)ulPortRaiseBASEPRI();
+    criticalNesting++;
+}
+
+void vPortExitCritical(void)
+{
+    criticalNesting--;
+    if (criticalNesting == 0u)
+        vPortSetBASEPRI(0u);
+}
+
+uint32_t ulPortRaiseBASEPRI(void)
+{
+    uint32_t old = simBasepri;
+
+    simBasepri = configMAX_SYSCALL_INTERRUPT_PRIORITY;
+    return old;
+}
+
+void vPortSetBASEPRI(uint32_t ulNewMask)
+{
+    simBasepri = ulNewMask;
+    if (ulNewMask == 0u)
+        sim_dispatch();
+}
+
+/* =========================================================
+ *  exception handlers (FreeRTOS.c installs them)
+ * =======================================================*/
+void xPortSysTickHandler(void)
+{
+    uint32_t m = ulPortRaiseBASEPRI();
+
+    if (xTaskIncrementTick() != pdFALSE)
+        switchPending = 1u;
+    vPortSetBASEPRI(m);
+}
+
+/* switches happen in vPortSwitchIfPending; nothing pends these */
+void xPortPendSVHandler(void)
+{
+}
+
+void vPortSVCHandler(void)
+{
+}
+
+/* =========================================================
+ *  tickless idle
+ * =======================================================*/
+/* As the CM3 port: SysTick is reprogrammed to fire when the expected
+ * idle time is up, the CPU waits with PRIMASK set (a pending interrupt
+ * still wakes it), and the ticks that passed are stepped in on the way
+ * out. */
+void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime)
+{
+    sim_irq_t *st   = &simIrq[SIM_IRQ_SYSTICK];
+    uint64_t   last = st->next - PORT_TICK_CYC;
+    TickType_t want = xExpectedIdleTime;
+    TickType_t idle, step;
+    uint64_t   due, k;
+
+    if (want > PORT_MAX_IDLE)
+        want = PORT_MAX_IDLE;
+    idle = want;
+
+    simPrimask = 1u;
+    if (eTaskConfirmSleepModeStatus() == eAbortSleep)
+    {
+        simPrimask = 0u;
+        sim_dispatch();
+        return;
+    }
+
+    due = last + (uint64_t)idle * PORT_TICK_CYC;
+    sim_schedule(SIM_IRQ_SYSTICK, due, 0u);
+    simSysTick.LOAD = (uint32_t)(due - simNow - 1u);
+    simSysTick.VAL  = simSysTick.LOAD;
+    configPRE_SLEEP_PROCESSING(idle);
+    if (idle)
+        sim_park();
+
+    /* SysTick as the post-sleep hook sees it: counting down to due,
+     * or reloaded with the tick pending once it got there */
+    if (simNow >= due)
+    {
+        simScb.ICSR    |= SCB_ICSR_PENDSTSET_Msk;
+        simSysTick.VAL  = simSysTick.LOAD - (uint32_t)(simNow - due);
+    }
+    else
+    {
+        simSysTick.VAL  = (uint32_t)(due - simNow - 1u);
+    }
+    configPOST_SLEEP_PROCESSING(want);
+    simScb.ICSR &= ~SCB_ICSR_PENDSTSET_Msk;
+
+    /* the tick whose SysTick is pending is counted by the handler */
+    k    = (simNow - last) / PORT_TICK_CYC;
+    step = (k >= want) ? want - 1u : (TickType_t)k;
+    if (step)
+        vTaskStepTick(step);
+    sim_schedule(SIM_IRQ_SYSTICK, last + (k + 1u) * PORT_TICK_CYC, PORT_TICK_CYC);
+    slept = 1u;
+
+    simPrimask = 0u;
+    sim_dispatch();
+}
+
+/* configUSE_IDLE_HOOK (port/FreeRTOSConfig.h): with tickless idle held
+ * off (power_hold) or not worth it, wait here for the next interrupt */
+void vApplicationIdleHook(void)
+{
+    if (!slept)
+        sim_wfi();
+    slept = 0u;
+}
@@ -0,0 +1,61 @@
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include <stdint.h>
+
+/* ---------- FreeRTOS port for the host simulator ----------
+ * Every task is a pthread, but only the one pxCurrentTCB names is ever
+ * running: a context switch hands a semaphore to the next thread and
+ * waits on its own. Simulated interrupts run on whichever task thread
+ * is current when virtual time reaches them (see sim/sim.c), so the
+ * kernel sees one CPU, as on the PSoC. BASEPRI and PRIMASK are modelled
+ * as plain masks that hold pending interrupts back.
+ */
+#define portCHAR           char
+#define portFLOAT          float
+#define portDOUBLE         double
+#define portLONG           long
+#define portSHORT          short
+/* wide enough for the pointer pxPortInitialiseStack parks on the stack */
+#define portSTACK_TYPE     uintptr_t
+#define portBASE_TYPE      long
+#define portPOINTER_SIZE_TYPE  uintptr_t
+
+typedef portSTACK_TYPE StackType_t;
+typedef long           BaseType_t;
+typedef unsigned long  UBaseType_t;
+
+typedef uint32_t TickType_t;
+#define portMAX_DELAY      ( TickType_t ) 0xffffffffUL
+#define portTICK_TYPE_IS_ATOMIC 1
+
+#define portSTACK_GROWTH   ( -1 )
+#define portTICK_PERIOD_MS ( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT 8
+#define portNOP()
+
+/* ---------- scheduling ---------- */
+void vPortYield( void );
+void vPortYieldFromISR( void );
+
+#define portYIELD()                     vPortYield()
+#define portEND_SWITCHING_ISR( x )      do { if( ( x ) != pdFALSE ) vPortYieldFromISR(); } while( 0 )
+#define portYIELD_FROM_ISR( x )         portEND_SWITCHING_ISR( x )
+
+/* ---------- interrupt masking ---------- */
+void     vPortEnterCritical( void );
+void     vPortExitCritical( void );
+uint32_t ulPortRaiseBASEPRI( void );
+void     vPortSetBASEPRI( uint32_t ulNewMask );
+
+#define portDISABLE_INTERRUPTS()                ( void ) ulPortRaiseBASEPRI()
+#define portENABLE_INTERRUPTS()                 vPortSetBASEPRI( 0 )
+#define portENTER_CRITICAL()                    vPortEnterCritical()
+#define portEXIT_CRITICAL()                     vPortExitCritical()
+#define portSET_INTERRUPT_MASK_FROM_ISR()       ulPortRaiseBASEPRI()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )  vPortSetBASEPRI( x )
+
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters )       void vFunction( void *pvParameters )
+
+#endif /* PORTMACRO_H */
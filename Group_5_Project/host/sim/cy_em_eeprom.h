@@ -0,0 +1,54 @@
+#ifndef CY_EM_EEPROM_H
+#define CY_EM_EEPROM_H
+
+/* ---------- emulated EEPROM, host build ----------
+ * Stands in for the Em_EEPROM_Dynamic 2.20 generated cy_em_eeprom.h:
+ * the API subset calib.c uses, with the component's size macros, kept
+ * in RAM (hal.c). Every run boots with an erased store unless --eeprom
+ * names a file to keep it in.
+ */
+#include "cytypes.h"
+
+#define CY_EM_EEPROM_VERSION_MAJOR          (2)
+#define CY_EM_EEPROM_VERSION_MINOR          (20)
+
+#define CY_EM_EEPROM_FLASH_SIZEOF_ROW       (256u)
+#define CY_EM_EEPROM_EEPROM_DATA_LEN        (CY_EM_EEPROM_FLASH_SIZEOF_ROW / 2u)
+#define CY_EM_EEPROM_GET_NUM_ROWS_IN_EEPROM(dataSize) \
+    (((dataSize) / (CY_EM_EEPROM_EEPROM_DATA_LEN)) + \
+     ((((dataSize) % (CY_EM_EEPROM_EEPROM_DATA_LEN)) != 0u) ? 1U : 0U))
+#define CY_EM_EEPROM_GET_PHYSICAL_SIZE(dataSize, wearLeveling, redundantCopy) \
+    (((CY_EM_EEPROM_GET_NUM_ROWS_IN_EEPROM(dataSize) * \
+       CY_EM_EEPROM_FLASH_SIZEOF_ROW) * (wearLeveling)) * (1uL + (redundantCopy)))
+
+typedef enum
+{
+    CY_EM_EEPROM_SUCCESS      = 0x00u,
+    CY_EM_EEPROM_BAD_PARAM    = 0x01u,
+    CY_EM_EEPROM_BAD_CHECKSUM = 0x02u,
+    CY_EM_EEPROM_BAD_DATA     = 0x03u,
+    CY_EM_EEPROM_WRITE_FAIL   = 0x04u
+} cy_en_em_eeprom_status_t;
+
+typedef struct
+{
+    uint32 eepromSize;
+    uint32 wearLevelingFactor;
+    uint8  redundantCopy;
+    uint8  blockingWrite;
+    uint32 userFlashStartAddr;
+} cy_stc_eeprom_config_t;
+
+typedef struct
+{
+    uint32 eepromSize;
+} cy_stc_eeprom_context_t;
+
+cy_en_em_eeprom_status_t Cy_Em_EEPROM_Init(cy_stc_eeprom_config_t *config,
+                                           cy_stc_eeprom_context_t *context);
+cy_en_em_eeprom_status_t Cy_Em_EEPROM_Read(uint32 addr, void *eepromData, uint32 size,
+                                           cy_stc_eeprom_context_t *context);
+cy_en_em_eeprom_status_t Cy_Em_EEPROM_Write(uint32 addr, void *eepromData, uint32 size,
+                                            cy_stc_eeprom_context_t *context);
+
+#endif /* CY_EM_EEPROM_H */
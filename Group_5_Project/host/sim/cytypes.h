@@ -0,0 +1,41 @@
+#ifndef CYTYPES_H
+#define CYTYPES_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* ---------- PSoC Creator base types, host build ----------
+ * Same names and widths as the generated cytypes.h; uint32 is
+ * uint32_t here so firmware that mixes the two still type-checks.
+ */
+typedef uint8_t   uint8;
+typedef uint16_t  uint16;
+typedef uint32_t  uint32;
+typedef uint64_t  uint64;
+typedef int8_t    int8;
+typedef int16_t   int16;
+typedef int32_t   int32;
+typedef int64_t   int64;
+typedef char      char8;
+typedef float     float32;
+typedef double    float64;
+typedef uint32    cystatus;
+
+typedef volatile uint8  reg8;
+typedef volatile uint16 reg16;
+typedef volatile uint32 reg32;
+
+typedef void (*cyisraddress)(void);
+
+#define CY_ISR(FuncName)        void FuncName(void)
+#define CY_ISR_PROTO(FuncName)  void FuncName(void)
+
+#define CY_INLINE               inline
+#define CY_ALIGN(align)         __attribute__((aligned(align)))
+#define CY_NOINIT
+#define CY_SECTION(name)
+
+#define CYRET_SUCCESS           (0x00u)
+#define CYRET_BAD_PARAM         (0x01u)
+
+#endif /* CYTYPES_H */
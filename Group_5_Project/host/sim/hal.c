@@ -0,0 +1,889 @@
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "project.h"
+#include "cy_em_eeprom.h"
+#include "sim.h"
+
+/* UART: 8N1 at 115200 */
+#define UART_BYTE_CYC      ((uint64_t)SIM_HZ * 10u / 115200u)
+#define UART_TX_FIFO       (UART_TX_BUFFER_SIZE)
+#define UART_RX_FIFO       (4u)
+
+/* SAR conversion: 18 ADC clocks at 12 bits */
+#define SAR1_CONV_CYC      ((uint64_t)SIM_HZ * 18u / ADC_SAR_1_CLOCK_FREQUENCY)
+#define SAR2_CONV_CYC      ((uint64_t)SIM_HZ * 18u / ADC_SAR_2_CLOCK_FREQUENCY)
+#define SAR_CODES          (4096)
+
+#define WAVE_CLK_CYC       ((uint64_t)SIM_HZ / 1000000u)   /* WaveClock, 1 MHz */
+
+/* the IDAC leaves compliance this far below VDDA */
+#define IDAC_HEADROOM_MV   (300.0)
+
+#define FNV_OFFSET         (0xcbf29ce484222325ull)
+#define FNV_PRIME          (0x100000001b3ull)
+
+hal_cfg_t halCfg =
+{
+    .scope    = HAL_SCOPE_VDAC,
+    .dutR     = 1000.0,
+    .dutC     = 100e-9,
+    .dutLeakR = 0.0,
+};
+
+int     halRxFd = -1, halTxFd = -1;
+uint8_t halRxEof;
+
+static uint64_t fnv(uint64_t h, const void *p, size_t n)
+{
+    const uint8_t *b = p;
+
+    while (n--)
+    {
+        h ^= *b++;
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+/* deterministic noise, the same for every run */
+static uint32_t rngState = 0x12345678u;
+
+static double noise_mv(void)
+{
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return ((double)rngState / 4294967296.0 * 2.0 - 1.0) * halCfg.noiseMv;
+}
+
+static int16 mv_to_code(double mv)
+{
+    long c = lround(mv * SAR_CODES / CYDEV_VDDA_MV);
+
+    if (c < 0)
+        c = 0;
+    if (c > SAR_CODES - 1)
+        c = SAR_CODES - 1;
+    return (int16)c;
+}
+
+/* =========================================================
+ *  CyLib
+ * =======================================================*/
+uint8 CyEnterCriticalSection(void)
+{
+    uint8 old = simPrimask;
+
+    simPrimask = 1u;
+    return old;
+}
+
+void CyExitCriticalSection(uint8 savedIntrStatus)
+{
+    simPrimask = savedIntrStatus;
+    if (!simPrimask)
+        sim_dispatch();
+}
+
+void CyGlobalIntEnable_(void)
+{
+    simPrimask = 0u;
+    sim_dispatch();
+}
+
+void CyGlobalIntDisable_(void)
+{
+    simPrimask = 1u;
+}
+
+void CyDelay(uint32 milliseconds)
+{
+    sim_delay((uint64_t)milliseconds * (SIM_HZ / 1000u));
+}
+
+void CyDelayUs(uint16 microseconds)
+{
+    sim_delay((uint64_t)microseconds * SIM_CYC_PER_US);
+}
+
+void CyIntEnable(uint8 number)
+{
+    if (number < SIM_IRQ_SYSTICK)
+        simIrq[number].enabled = 1u;
+    sim_dispatch();
+}
+
+void CyIntDisable(uint8 number)
+{
+    if (number < SIM_IRQ_SYSTICK)
+        simIrq[number].enabled = 0u;
+}
+
+void CyIntSetPriority(uint8 number, uint8 priority)
+{
+    if (number < SIM_IRQ_SYSTICK)
+        simIrq[number].prio = priority & 7u;
+}
+
+uint8 CyIntGetPriority(uint8 number)
+{
+    return (number < SIM_IRQ_SYSTICK) ? simIrq[number].prio : 0u;
+}
+
+void CyIntClearPending(uint8 number)
+{
+    if (number < SIM_IRQ_SYSTICK)
+        simIrq[number].pending = 0u;
+}
+
+void CyIntSetPending(uint8 number)
+{
+    if (number < SIM_IRQ_SYSTICK)
+        simIrq[number].pending = 1u;
+    sim_dispatch();
+}
+
+cyisraddress CyIntSetVector(uint8 number, cyisraddress address)
+{
+    cyisraddress old = NULL;
+
+    if (number < SIM_IRQ_SYSTICK)
+    {
+        old = simIrq[number].vector;
+        simIrq[number].vector = address;
+    }
+    return old;
+}
+
+/* only SysTick is an event here; SVC and PendSV are port calls */
+cyisraddress CyIntSetSysVector(uint8 number, cyisraddress address)
+{
+    cyisraddress old = NULL;
+
+    if (number == 16 + SysTick_IRQn)
+    {
+        old = simIrq[SIM_IRQ_SYSTICK].vector;
+        simIrq[SIM_IRQ_SYSTICK].vector = address;
+    }
+    return old;
+}
+
+void CyPmAltAct(uint16 wakeupTime, uint16 wakeupSource)
+{
+    (void)wakeupTime;
+    (void)wakeupSource;
+    sim_park();
+}
+
+void CyPmSleep(uint8 wakeupTime, uint16 wakeupSource)
+{
+    (void)wakeupTime;
+    (void)wakeupSource;
+    sim_park();
+}
+
+/* =========================================================
+ *  ADC_SAR_1 + isr_adc: scope input
+ * =======================================================*/
+static int16    sar1Result;
+static uint64_t sar1Count;
+static uint8    vdacCode;
+
+static double scope_mv(void)
+{
+    double mv;
+
+    switch (halCfg.scope)
+    {
+    case HAL_SCOPE_SINE:
+        mv = halCfg.sineOffMv + halCfg.sineMvpp / 2.0 *
+             sin(2.0 * M_PI * halCfg.sineHz * (double)simNow / SIM_HZ);
+        break;
+    case HAL_SCOPE_FILE:
+        mv = halCfg.fileMv[sar1Count % halCfg.fileLen];
+        break;
+    default:
+        mv = (double)vdacCode * 16.0;     /* VDAC8_1 wired back to the scope */
+        break;
+    }
+    return mv + noise_mv();
+}
+
+static uint8_t sar1_due(void)
+{
+    sar1Result = mv_to_code(scope_mv());
+    sar1Count++;
+    return 1u;
+}
+
+void ADC_SAR_1_Start(void)
+{
+    simIrq[SIM_IRQ_SCOPE].due = sar1_due;
+}
+
+void ADC_SAR_1_Stop(void)
+{
+    ADC_SAR_1_StopConvert();
+}
+
+void ADC_SAR_1_StartConvert(void)
+{
+    sim_schedule(SIM_IRQ_SCOPE, simNow + SAR1_CONV_CYC, SAR1_CONV_CYC);
+}
+
+void ADC_SAR_1_StopConvert(void)
+{
+    sim_schedule(SIM_IRQ_SCOPE, SIM_NEVER, 0u);
+}
+
+int16 ADC_SAR_1_GetResult16(void)
+{
+    return sar1Result;
+}
+
+/* isr_adc is the SAR's EOC line */
+void isr_adc_StartEx(cyisraddress address)
+{
+    simIrq[SIM_IRQ_SCOPE].vector  = address;
+    simIrq[SIM_IRQ_SCOPE].pending = 0u;
+    simIrq[SIM_IRQ_SCOPE].enabled = 1u;
+}
+
+void isr_adc_Stop(void)
+{
+    simIrq[SIM_IRQ_SCOPE].enabled = 0u;
+}
+
+void isr_adc_Enable(void)
+{
+    simIrq[SIM_IRQ_SCOPE].enabled = 1u;
+}
+
+void isr_adc_Disable(void)
+{
+    simIrq[SIM_IRQ_SCOPE].enabled = 0u;
+}
+
+void isr_adc_ClearPending(void)
+{
+    simIrq[SIM_IRQ_SCOPE].pending = 0u;
+}
+
+void isr_adc_SetPriority(uint8 priority)
+{
+    CyIntSetPriority(isr_adc__INTC_NUMBER, priority);
+}
+
+/* =========================================================
+ *  IDAC_1, AMux_1, Pin_R, Pin_C: meter DUT
+ * =======================================================*/
+/* The IDAC current goes into whichever pin AMux_1 selects. Pin_R has
+ * halCfg.dutR to ground (0: open); Pin_C has halCfg.dutC, with
+ * halCfg.dutLeakR across it (0: none), and is shorted while Pin_C
+ * drives strong low. The pin voltage clamps at the IDAC compliance. */
+static uint8    idacOn, idacCode, idacRange, idacSink;
+static uint8    amuxCh;
+static uint8    pinCMode, pinCOut;
+static double   vCap;             /* volts */
+static uint64_t capAt;
+
+static double idac_amps(void)
+{
+    double lsb;
+
+    if (!idacOn || idacSink)
+        return 0.0;
+    lsb = (idacRange == IDAC_1_RANGE_2mA)   ? 8000e-9 :
+          (idacRange == IDAC_1_RANGE_255uA) ? 1000e-9 : 125e-9;
+    return lsb * idacCode;
+}
+
+static double v_max(void)
+{
+    return (CYDEV_VDDA_MV - IDAC_HEADROOM_MV) / 1000.0;
+}
+
+/* bring the capacitor up to now under the present drive */
+static void cap_update(void)
+{
+    double dt = (double)(simNow - capAt) / SIM_HZ;
+    double i  = (amuxCh == 1u) ? idac_amps() : 0.0;
+
+    capAt = simNow;
+    if ((pinCMode == Pin_C_DM_STRONG) && !pinCOut)
+    {
+        vCap = 0.0;
+        return;
+    }
+    if (halCfg.dutC <= 0.0)
+        return;
+    if (halCfg.dutLeakR > 0.0)
+    {
+        /* exact step toward I*R with tau = R*C */
+        double vinf = i * halCfg.dutLeakR;
+        vCap = vinf + (vCap - vinf) * exp(-dt / (halCfg.dutLeakR * halCfg.dutC));
+    }
+    else
+    {
+        vCap += i * dt / halCfg.dutC;
+    }
+    if (vCap > v_max())
+        vCap = v_max();
+}
+
+static double meter_volts(void)
+{
+    double v;
+
+    cap_update();
+    if (amuxCh == 1u)
+        return vCap;
+    if (halCfg.dutR <= 0.0)
+        return (idac_amps() > 0.0) ? v_max() : 0.0;
+    v = idac_amps() * halCfg.dutR;
+    return (v > v_max()) ? v_max() : v;
+}
+
+void IDAC_1_Start(void)
+{
+    cap_update();
+    idacOn = 1u;
+}
+
+void IDAC_1_Stop(void)
+{
+    cap_update();
+    idacOn = 0u;
+}
+
+void IDAC_1_SetValue(uint8 value)
+{
+    cap_update();
+    idacCode = value;
+}
+
+void IDAC_1_SetRange(uint8 range)
+{
+    cap_update();
+    idacRange = range;
+}
+
+void IDAC_1_SetPolarity(uint8 polarity)
+{
+    cap_update();
+    idacSink = (polarity == IDAC_1_SINK) ? 1u : 0u;
+}
+
+void AMux_1_Start(void)
+{
+}
+
+void AMux_1_FastSelect(uint8 channel)
+{
+    cap_update();
+    amuxCh = channel;
+}
+
+void Pin_R_SetDriveMode(uint8 mode)
+{
+    (void)mode;
+}
+
+void Pin_R_Write(uint8 value)
+{
+    (void)value;
+}
+
+void Pin_C_SetDriveMode(uint8 mode)
+{
+    cap_update();
+    pinCMode = mode;
+}
+
+void Pin_C_Write(uint8 value)
+{
+    cap_update();
+    pinCOut = value;
+}
+
+/* =========================================================
+ *  ADC_SAR_2: meter
+ * =======================================================*/
+volatile int32 ADC_SAR_2_countsPer10Volt = 2 * SAR_CODES;
+volatile int16 ADC_SAR_2_offset;
+
+static int16 sar2Result;
+static uint8 sar2Fresh;
+
+static uint8_t sar2_due(void)
+{
+    sar2Result = mv_to_code(meter_volts() * 1000.0 + noise_mv());
+    sar2Fresh  = 1u;
+    return 1u;
+}
+
+void ADC_SAR_2_Start(void)
+{
+    simIrq[SIM_IRQ_SAR2].due    = sar2_due;
+    simIrq[SIM_IRQ_SAR2].vector = ADC_SAR_2_ISR;
+}
+
+void ADC_SAR_2_Stop(void)
+{
+    ADC_SAR_2_StopConvert();
+}
+
+void ADC_SAR_2_StartConvert(void)
+{
+    sim_schedule(SIM_IRQ_SAR2, simNow + SAR2_CONV_CYC, SAR2_CONV_CYC);
+}
+
+void ADC_SAR_2_StopConvert(void)
+{
+    sim_schedule(SIM_IRQ_SAR2, SIM_NEVER, 0u);
+}
+
+uint8 ADC_SAR_2_IsEndConversion(uint8 retMode)
+{
+    if (retMode == ADC_SAR_2_WAIT_FOR_RESULT)
+    {
+        while (!sar2Fresh && (simIrq[SIM_IRQ_SAR2].next != SIM_NEVER))
+            sim_advance_to(simIrq[SIM_IRQ_SAR2].next);
+    }
+    return sar2Fresh;
+}
+
+int16 ADC_SAR_2_GetResult16(void)
+{
+    sar2Fresh = 0u;
+    return sar2Result;
+}
+
+int16 ADC_SAR_2_CountsTo_mVolts(int16 adcCounts)
+{
+    return (int16)((((int32)adcCounts - ADC_SAR_2_offset) * ADC_SAR_2_10MV_COUNTS) /
+                   ADC_SAR_2_countsPer10Volt);
+}
+
+int32 ADC_SAR_2_CountsTo_uVolts(int16 adcCounts)
+{
+    return (int32)(((int64)((int32)adcCounts - ADC_SAR_2_offset) * ADC_SAR_2_10UV_COUNTS) /
+                   ADC_SAR_2_countsPer10Volt);
+}
+
+CY_ISR(ADC_SAR_2_ISR)
+{
+#ifdef ADC_SAR_2_ISR_INTERRUPT_CALLBACK
+    ADC_SAR_2_ISR_InterruptCallback();
+#endif
+}
+
+void ADC_SAR_2_IRQ_SetPriority(uint8 priority)
+{
+    CyIntSetPriority(ADC_SAR_2_INTC_NUMBER, priority);
+}
+
+/* =========================================================
+ *  VDAC8_1, WaveClock, WaveTimer, isr_wave: generator
+ * =======================================================*/
+static uint16   wavePeriod;
+static uint8    waveRunning, waveTc;
+static uint64_t vdacWrites, vdacHash = FNV_OFFSET;
+static FILE    *vdacOut;
+
+static uint8_t wave_due(void)
+{
+    waveTc = 1u;
+    return 1u;
+}
+
+void VDAC8_1_Start(void)
+{
+}
+
+void VDAC8_1_Stop(void)
+{
+}
+
+/* the hash covers the code and the cycle it was written in, so a
+ * generator timing change shows up as well as a value change */
+void VDAC8_1_SetValue(uint8 value)
+{
+    vdacCode = value;
+    vdacWrites++;
+    vdacHash = fnv(vdacHash, &simNow, sizeof(simNow));
+    vdacHash = fnv(vdacHash, &value, 1u);
+    if (vdacOut != NULL)
+    {
+        uint8_t rec[9];
+        uint8_t i;
+
+        for (i = 0u; i < 8u; i++)
+            rec[i] = (uint8_t)(simNow >> (8u * i));
+        rec[8] = value;
+        fwrite(rec, 1u, sizeof(rec), vdacOut);
+    }
+}
+
+void WaveClock_Start(void)
+{
+}
+
+void WaveClock_Stop(void)
+{
+}
+
+static uint64_t wave_cyc(void)
+{
+    return ((uint64_t)wavePeriod + 1u) * WAVE_CLK_CYC;
+}
+
+void WaveTimer_Start(void)
+{
+    simIrq[SIM_IRQ_WAVE].due = wave_due;
+    waveRunning = 1u;
+    sim_schedule(SIM_IRQ_WAVE, simNow + wave_cyc(), wave_cyc());
+}
+
+void WaveTimer_Stop(void)
+{
+    waveRunning = 0u;
+    sim_schedule(SIM_IRQ_WAVE, SIM_NEVER, 0u);
+}
+
+/* a restart from the new count is what Start does anyway */
+void WaveTimer_WriteCounter(uint16 counter)
+{
+    (void)counter;
+}
+
+/* takes effect at the next terminal count, as the hardware reloads */
+void WaveTimer_WritePeriod(uint16 period)
+{
+    wavePeriod = period;
+    if (waveRunning)
+        simIrq[SIM_IRQ_WAVE].period = wave_cyc();
+}
+
+uint16 WaveTimer_ReadPeriod(void)
+{
+    return wavePeriod;
+}
+
+uint8 WaveTimer_ReadStatusRegister(void)
+{
+    uint8 s = waveTc;
+
+    waveTc = 0u;
+    return s;
+}
+
+void isr_wave_StartEx(cyisraddress address)
+{
+    simIrq[SIM_IRQ_WAVE].vector  = address;
+    simIrq[SIM_IRQ_WAVE].pending = 0u;
+    simIrq[SIM_IRQ_WAVE].enabled = 1u;
+}
+
+void isr_wave_Stop(void)
+{
+    simIrq[SIM_IRQ_WAVE].enabled = 0u;
+}
+
+void isr_wave_Enable(void)
+{
+    simIrq[SIM_IRQ_WAVE].enabled = 1u;
+}
+
+void isr_wave_Disable(void)
+{
+    simIrq[SIM_IRQ_WAVE].enabled = 0u;
+}
+
+void isr_wave_ClearPending(void)
+{
+    simIrq[SIM_IRQ_WAVE].pending = 0u;
+}
+
+void isr_wave_SetPriority(uint8 priority)
+{
+    CyIntSetPriority(isr_wave__INTC_NUMBER, priority);
+}
+
+/* =========================================================
+ *  UART
+ * =======================================================*/
+uint8 UART_errorStatus;
+
+/* host bytes not yet on the wire */
+static uint8    inQ[4096];
+static uint32   inHead, inCount;
+
+static uint8    rxFifo[UART_RX_FIFO];
+static uint8    rxFifoN;
+static uint8    rxBuf[UART_RX_BUFFER_SIZE];
+static uint8    rxHead, rxCount;
+
+static uint64_t txIdleAt;           /* FIFO and shifter empty */
+static uint8    outBuf[4096];
+static uint32   outLen;
+static uint64_t txBytes, txDrops, txHash = FNV_OFFSET;
+static uint64_t rxBytes, rxHash = FNV_OFFSET;
+
+static void out_flush(void)
+{
+    uint32 off = 0u;
+
+    while (off < outLen)
+    {
+        ssize_t n = write(halTxFd, outBuf + off, outLen - off);
+
+        if (n > 0)
+        {
+            off += (uint32)n;
+            continue;
+        }
+        if ((n < 0) && (errno == EINTR))
+            continue;
+        /* nobody reading the pty: the bytes go on the floor, as on
+         * a board with no cable */
+        txDrops += outLen - off;
+        break;
+    }
+    outLen = 0u;
+}
+
+/* one byte off the wire into the hardware FIFO */
+static uint8_t uart_rx_due(void)
+{
+    uint8 b;
+
+    if (inCount == 0u)
+    {
+        sim_schedule(SIM_IRQ_UART, SIM_NEVER, 0u);
+        return 0u;
+    }
+    b = inQ[inHead];
+    inHead = (inHead + 1u) % sizeof(inQ);
+    inCount--;
+    rxBytes++;
+    rxHash = fnv(rxHash, &b, 1u);
+
+    if (rxFifoN < UART_RX_FIFO)
+        rxFifo[rxFifoN++] = b;
+    else
+        UART_errorStatus |= UART_RX_STS_OVERRUN;
+    return 1u;
+}
+
+/* the component's RX ISR: hardware FIFO into the software buffer */
+static CY_ISR(UART_RXISR)
+{
+    uint8 i;
+
+    for (i = 0u; i < rxFifoN; i++)
+    {
+        if (rxCount < UART_RX_BUFFER_SIZE)
+        {
+            rxBuf[(rxHead + rxCount) % UART_RX_BUFFER_SIZE] = rxFifo[i];
+            rxCount++;
+        }
+        else
+        {
+            UART_errorStatus |= UART_RX_STS_SOFT_BUFF_OVER;
+        }
+    }
+    rxFifoN = 0u;
+#ifdef UART_RXISR_EXIT_CALLBACK
+    UART_RXISR_ExitCallback();
+#endif
+}
+
+void hal_poll_input(void)
+{
+    if (outLen)
+        out_flush();
+    if ((halRxFd < 0) || halRxEof)
+        return;
+
+    while (inCount < sizeof(inQ))
+    {
+        uint32  tail = (inHead + inCount) % sizeof(inQ);
+        uint32  room = (tail >= inHead) ? (uint32)sizeof(inQ) - tail : inHead - tail;
+        ssize_t n    = read(halRxFd, inQ + tail, room);
+
+        if (n > 0)
+        {
+            inCount += (uint32)n;
+            continue;
+        }
+        if (n == 0)
+        {
+            halRxEof = 1u;
+            if ((simEofGrace != 0u) && (simEnd == SIM_NEVER))
+                simEnd = simNow + simEofGrace;
+        }
+        break;
+    }
+    if (inCount && (simIrq[SIM_IRQ_UART].next == SIM_NEVER))
+        sim_schedule(SIM_IRQ_UART, simNow + UART_BYTE_CYC, UART_BYTE_CYC);
+}
+
+void UART_Start(void)
+{
+    simIrq[SIM_IRQ_UART].due     = uart_rx_due;
+    simIrq[SIM_IRQ_UART].vector  = UART_RXISR;
+    simIrq[SIM_IRQ_UART].enabled = 1u;
+    hal_poll_input();
+}
+
+void UART_Stop(void)
+{
+    simIrq[SIM_IRQ_UART].enabled = 0u;
+}
+
+/* blocks while the 4-byte FIFO is full, like the component */
+void UART_PutChar(uint8 txDataByte)
+{
+    uint64_t full = UART_TX_FIFO * UART_BYTE_CYC;
+
+    if (txIdleAt > simNow + full)
+        sim_advance_to(txIdleAt - full);
+    txIdleAt = ((txIdleAt > simNow) ? txIdleAt : simNow) + UART_BYTE_CYC;
+
+    txBytes++;
+    txHash = fnv(txHash, &txDataByte, 1u);
+    outBuf[outLen++] = txDataByte;
+    if (outLen == sizeof(outBuf))
+        out_flush();
+}
+
+void UART_PutArray(const uint8 string[], uint8 byteCount)
+{
+    uint8 i;
+
+    for (i = 0u; i < byteCount; i++)
+        UART_PutChar(string[i]);
+}
+
+void UART_PutString(const char8 string[])
+{
+    while (*string)
+        UART_PutChar((uint8)*string++);
+}
+
+uint8 UART_GetRxBufferSize(void)
+{
+    return rxCount;
+}
+
+uint8 UART_ReadRxData(void)
+{
+    uint8 b = 0u;
+
+    if (rxCount)
+    {
+        b = rxBuf[rxHead];
+        rxHead = (uint8)((rxHead + 1u) % UART_RX_BUFFER_SIZE);
+        rxCount--;
+    }
+    return b;
+}
+
+void UART_ClearRxBuffer(void)
+{
+    rxHead  = 0u;
+    rxCount = 0u;
+}
+
+/* =========================================================
+ *  cy_em_eeprom: in RAM, optionally backed by a file
+ * =======================================================*/
+static uint8 eeData[CY_EM_EEPROM_EEPROM_DATA_LEN];
+
+static void ee_save(void)
+{
+    FILE *f;
+
+    if (halCfg.eepromPath == NULL)
+        return;
+    f = fopen(halCfg.eepromPath, "wb");
+    if (f == NULL)
+        return;
+    fwrite(eeData, 1u, sizeof(eeData), f);
+    fclose(f);
+}
+
+cy_en_em_eeprom_status_t Cy_Em_EEPROM_Init(cy_stc_eeprom_config_t *config,
+                                           cy_stc_eeprom_context_t *context)
+{
+    if ((config == NULL) || (context == NULL) || (config->eepromSize > sizeof(eeData)))
+        return CY_EM_EEPROM_BAD_PARAM;
+    context->eepromSize = config->eepromSize;
+    return CY_EM_EEPROM_SUCCESS;
+}
+
+cy_en_em_eeprom_status_t Cy_Em_EEPROM_Read(uint32 addr, void *eepromData, uint32 size,
+                                           cy_stc_eeprom_context_t *context)
+{
+    if ((addr + size) > context->eepromSize)
+        return CY_EM_EEPROM_BAD_PARAM;
+    memcpy(eepromData, eeData + addr, size);
+    return CY_EM_EEPROM_SUCCESS;
+}
+
+cy_en_em_eeprom_status_t Cy_Em_EEPROM_Write(uint32 addr, void *eepromData, uint32 size,
+                                            cy_stc_eeprom_context_t *context)
+{
+    if ((addr + size) > context->eepromSize)
+        return CY_EM_EEPROM_BAD_PARAM;
+    memcpy(eeData + addr, eepromData, size);
+    ee_save();
+    /* a row write stalls the CPU for about 15 ms */
+    sim_delay((uint64_t)SIM_HZ * 15u / 1000u);
+    return CY_EM_EEPROM_SUCCESS;
+}
+
+/* =========================================================
+ *  host side
+ * =======================================================*/
+void hal_init(void)
+{
+    if (halCfg.eepromPath != NULL)
+    {
+        FILE *f = fopen(halCfg.eepromPath, "rb");
+
+        if (f != NULL)
+        {
+            if (fread(eeData, 1u, sizeof(eeData), f) != sizeof(eeData))
+                memset(eeData, 0, sizeof(eeData));
+            fclose(f);
+        }
+    }
+    if (halCfg.vdacPath != NULL)
+    {
+        vdacOut = fopen(halCfg.vdacPath, "wb");
+        if (vdacOut == NULL)
+            fprintf(stderr, "sim: cannot write %s\n", halCfg.vdacPath);
+    }
+}
+
+void hal_report(FILE *f)
+{
+    if (outLen)
+        out_flush();
+    if (vdacOut != NULL)
+        fflush(vdacOut);
+
+    fprintf(f, "uart tx   %llu bytes  fnv %016llx  dropped %llu\n",
+            (unsigned long long)txBytes, (unsigned long long)txHash,
+            (unsigned long long)txDrops);
+    fprintf(f, "uart rx   %llu bytes  fnv %016llx\n",
+            (unsigned long long)rxBytes, (unsigned long long)rxHash);
+    fprintf(f, "vdac      %llu writes fnv %016llx\n",
+            (unsigned long long)vdacWrites, (unsigned long long)vdacHash);
+    fprintf(f, "scope     %llu conversions\n", (unsigned long long)sar1Count);
+}
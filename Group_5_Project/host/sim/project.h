@@ -0,0 +1,242 @@
+#ifndef PROJECT_H
+#define PROJECT_H
+
+/* ---------- simulated PSoC 5LP HAL ----------
+ * Stands in for the PSoC Creator generated project.h: the component
+ * APIs, CyLib and the CMSIS bits the firmware uses, with the same
+ * names, constants and interrupt numbers as codegentemp. hal.c
+ * implements them on the virtual clock in sim.c.
+ */
+#include "cytypes.h"
+#include "cyapicallbacks.h"
+
+/* ---------- clocks and supplies (cyfitter.h) ---------- */
+#define BCLK__BUS_CLK__HZ      24000000U
+#define BCLK__BUS_CLK__KHZ     24000U
+#define BCLK__BUS_CLK__MHZ     24U
+#define CYDEV_VDDA             5.0
+#define CYDEV_VDDA_MV          5000
+
+/* ---------- interrupt numbers (cyfitter.h) ---------- */
+#define ADC_SAR_1_IRQ__INTC_NUMBER             0u
+#define ADC_SAR_2_IRQ__INTC_NUMBER             1u
+#define UART_RXInternalInterrupt__INTC_NUMBER  2u
+#define isr_adc__INTC_NUMBER                   3u
+#define isr_wave__INTC_NUMBER                  4u
+#define CY_INT_IRQ_COUNT                       5u
+
+/* ---------- CMSIS core ---------- */
+typedef enum
+{
+    SVCall_IRQn  = -5,
+    PendSV_IRQn  = -2,
+    SysTick_IRQn = -1
+} IRQn_Type;
+
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+    volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+/* set by port.c around a tickless sleep, as the hardware would read */
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t LOAD;
+    volatile uint32_t VAL;
+} SysTick_Type;
+
+typedef struct
+{
+    volatile uint32_t ICSR;
+} SCB_Type;
+
+extern DWT_Type       simDwt;
+extern CoreDebug_Type simCoreDebug;
+extern SysTick_Type   simSysTick;
+extern SCB_Type       simScb;
+
+#define DWT                          (&simDwt)
+#define CoreDebug                    (&simCoreDebug)
+#define SysTick                      (&simSysTick)
+#define SCB                          (&simScb)
+#define DWT_CTRL_CYCCNTENA_Msk       (1UL)
+#define CoreDebug_DEMCR_TRCENA_Msk   (1UL << 24)
+#define SCB_ICSR_PENDSTSET_Msk       (1UL << 26)
+
+/* one simulated CPU: nothing runs between LDREX and STREX, so the
+ * store always succeeds */
+static inline uint32_t __LDREXW(volatile uint32_t *addr)
+{
+    return *addr;
+}
+
+static inline uint32_t __STREXW(uint32_t value, volatile uint32_t *addr)
+{
+    *addr = value;
+    return 0u;
+}
+
+static inline void __CLREX(void)
+{
+}
+
+#define __DMB()                      __asm__ volatile ("" ::: "memory")
+#define __DSB()                      __DMB()
+#define __ISB()                      __DMB()
+
+/* exception number of the running simulated ISR, 0 in a task */
+uint32_t __get_IPSR(void);
+
+/* ---------- CyLib ---------- */
+uint8  CyEnterCriticalSection(void);
+void   CyExitCriticalSection(uint8 savedIntrStatus);
+void   CyGlobalIntEnable_(void);
+void   CyGlobalIntDisable_(void);
+#define CyGlobalIntEnable            CyGlobalIntEnable_()
+#define CyGlobalIntDisable           CyGlobalIntDisable_()
+
+void   CyDelay(uint32 milliseconds);
+void   CyDelayUs(uint16 microseconds);
+
+void   CyIntEnable(uint8 number);
+void   CyIntDisable(uint8 number);
+void   CyIntSetPriority(uint8 number, uint8 priority);
+uint8  CyIntGetPriority(uint8 number);
+void   CyIntClearPending(uint8 number);
+void   CyIntSetPending(uint8 number);
+cyisraddress CyIntSetVector(uint8 number, cyisraddress address);
+cyisraddress CyIntSetSysVector(uint8 number, cyisraddress address);
+
+/* ---------- power management (cyPm.h) ---------- */
+#define PM_ALT_ACT_TIME_NONE         (0x0000u)
+#define PM_ALT_ACT_SRC_NONE          (0x0000u)
+#define PM_ALT_ACT_SRC_INTERRUPT     (0x0400u)
+#define PM_SLEEP_TIME_NONE           (0x0000u)
+#define PM_SLEEP_SRC_NONE            (0x0000u)
+
+void   CyPmAltAct(uint16 wakeupTime, uint16 wakeupSource);
+void   CyPmSleep(uint8 wakeupTime, uint16 wakeupSource);
+
+/* ---------- ADC_SAR_1: scope ---------- */
+#define ADC_SAR_1_CLOCK_FREQUENCY    (1080000u)
+#define ADC_SAR_1_DEFAULT_RESOLUTION (12u)
+
+void   ADC_SAR_1_Start(void);
+void   ADC_SAR_1_Stop(void);
+void   ADC_SAR_1_StartConvert(void);
+void   ADC_SAR_1_StopConvert(void);
+int16  ADC_SAR_1_GetResult16(void);
+
+void   isr_adc_StartEx(cyisraddress address);
+void   isr_adc_Stop(void);
+void   isr_adc_Enable(void);
+void   isr_adc_Disable(void);
+void   isr_adc_ClearPending(void);
+void   isr_adc_SetPriority(uint8 priority);
+
+/* ---------- ADC_SAR_2: meter ---------- */
+#define ADC_SAR_2_CLOCK_FREQUENCY    (1000008u)
+#define ADC_SAR_2_DEFAULT_RESOLUTION (12u)
+#define ADC_SAR_2_INTC_NUMBER        ((uint8)ADC_SAR_2_IRQ__INTC_NUMBER)
+#define ADC_SAR_2_RETURN_STATUS      (1u)
+#define ADC_SAR_2_WAIT_FOR_RESULT    (0u)
+#define ADC_SAR_2_10MV_COUNTS        (10000)
+#define ADC_SAR_2_10UV_COUNTS        (10000000L)
+
+extern volatile int32 ADC_SAR_2_countsPer10Volt;
+extern volatile int16 ADC_SAR_2_offset;
+
+void   ADC_SAR_2_Start(void);
+void   ADC_SAR_2_Stop(void);
+void   ADC_SAR_2_StartConvert(void);
+void   ADC_SAR_2_StopConvert(void);
+uint8  ADC_SAR_2_IsEndConversion(uint8 retMode);
+int16  ADC_SAR_2_GetResult16(void);
+int16  ADC_SAR_2_CountsTo_mVolts(int16 adcCounts);
+int32  ADC_SAR_2_CountsTo_uVolts(int16 adcCounts);
+CY_ISR_PROTO(ADC_SAR_2_ISR);
+void   ADC_SAR_2_IRQ_SetPriority(uint8 priority);
+
+/* ---------- IDAC_1, AMux_1, Pin_R, Pin_C: meter front end ---------- */
+#define IDAC_1_RANGE_32uA            (0x00u)
+#define IDAC_1_RANGE_255uA           (0x04u)
+#define IDAC_1_RANGE_2mA             (0x08u)
+#define IDAC_1_SOURCE                (0x00u)
+#define IDAC_1_SINK                  (0x04u)
+
+void   IDAC_1_Start(void);
+void   IDAC_1_Stop(void);
+void   IDAC_1_SetValue(uint8 value);
+void   IDAC_1_SetRange(uint8 range);
+void   IDAC_1_SetPolarity(uint8 polarity);
+
+void   AMux_1_Start(void);
+void   AMux_1_FastSelect(uint8 channel);
+
+#define PIN_DM_ALG_HIZ               (0u)
+#define PIN_DM_DIG_HIZ               (1u)
+#define PIN_DM_RES_UP                (2u)
+#define PIN_DM_RES_DWN               (3u)
+#define PIN_DM_OD_LO                 (4u)
+#define PIN_DM_OD_HI                 (5u)
+#define PIN_DM_STRONG                (6u)
+#define PIN_DM_RES_UPDWN             (7u)
+
+#define Pin_R_DM_ALG_HIZ             PIN_DM_ALG_HIZ
+#define Pin_R_DM_STRONG              PIN_DM_STRONG
+#define Pin_C_DM_ALG_HIZ             PIN_DM_ALG_HIZ
+#define Pin_C_DM_STRONG              PIN_DM_STRONG
+
+void   Pin_R_SetDriveMode(uint8 mode);
+void   Pin_R_Write(uint8 value);
+void   Pin_C_SetDriveMode(uint8 mode);
+void   Pin_C_Write(uint8 value);
+
+/* ---------- VDAC8_1, WaveClock, WaveTimer: generator ---------- */
+void   VDAC8_1_Start(void);
+void   VDAC8_1_Stop(void);
+void   VDAC8_1_SetValue(uint8 value);
+
+void   WaveClock_Start(void);
+void   WaveClock_Stop(void);
+
+void   WaveTimer_Start(void);
+void   WaveTimer_Stop(void);
+void   WaveTimer_WriteCounter(uint16 counter);
+void   WaveTimer_WritePeriod(uint16 period);
+uint16 WaveTimer_ReadPeriod(void);
+uint8  WaveTimer_ReadStatusRegister(void);
+
+void   isr_wave_StartEx(cyisraddress address);
+void   isr_wave_Stop(void);
+void   isr_wave_Enable(void);
+void   isr_wave_Disable(void);
+void   isr_wave_ClearPending(void);
+void   isr_wave_SetPriority(uint8 priority);
+
+/* ---------- UART ---------- */
+#define UART_TX_BUFFER_SIZE          (4u)
+#define UART_RX_BUFFER_SIZE          (16u)
+#define UART_RX_VECT_NUM             ((uint8)UART_RXInternalInterrupt__INTC_NUMBER)
+#define UART_RX_STS_OVERRUN          ((uint8)(0x01u << 4))
+#define UART_RX_STS_SOFT_BUFF_OVER   ((uint8)(0x01u << 7))
+
+extern uint8 UART_errorStatus;
+
+void   UART_Start(void);
+void   UART_Stop(void);
+void   UART_PutChar(uint8 txDataByte);
+void   UART_PutArray(const uint8 string[], uint8 byteCount);
+void   UART_PutString(const char8 string[]);
+uint8  UART_GetRxBufferSize(void);
+uint8  UART_ReadRxData(void);
+void   UART_ClearRxBuffer(void);
+
+#endif /* PROJECT_H */
@@ -0,0 +1,243 @@
+#include <signal.h>
+#include <stdlib.h>
+#include <time.h>
+#include "project.h"
+#include "sim.h"
+
+/* NVIC priority bits of the PSoC 5LP: BASEPRI holds prio << 5 */
+#define SIM_PRIO_SHIFT     5u
+
+sim_irq_t simIrq[SIM_IRQ_COUNT] =
+{
+    [SIM_IRQ_SAR1]    = { .name = "ADC_SAR_1_IRQ", .next = SIM_NEVER, .prio = 7u },
+    [SIM_IRQ_SAR2]    = { .name = "ADC_SAR_2_IRQ", .next = SIM_NEVER, .prio = 7u },
+    [SIM_IRQ_UART]    = { .name = "UART_RX",       .next = SIM_NEVER, .prio = 7u },
+    [SIM_IRQ_SCOPE]   = { .name = "isr_adc",       .next = SIM_NEVER, .prio = 7u },
+    [SIM_IRQ_WAVE]    = { .name = "isr_wave",      .next = SIM_NEVER, .prio = 7u },
+    [SIM_IRQ_SYSTICK] = { .name = "SysTick",       .next = SIM_NEVER, .prio = 7u },
+};
+
+uint64_t simNow;
+uint32_t simBasepri;
+uint8_t  simPrimask;
+
+DWT_Type       simDwt;
+CoreDebug_Type simCoreDebug;
+SysTick_Type   simSysTick;
+SCB_Type       simScb;
+
+static uint32_t activeIrq;            /* IPSR of the running vector */
+static uint8_t  parked;               /* core halted in WFI: DWT holds */
+static uint64_t nextPoll;             /* next look at the host UART */
+static uint64_t wallStart;
+static volatile sig_atomic_t stopReq;
+
+static uint64_t host_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void on_sigint(int sig)
+{
+    (void)sig;
+    stopReq = 1;
+}
+
+/* --realtime: never run more than a millisecond ahead of the wall */
+static void pace(uint64_t t)
+{
+    uint64_t want = wallStart + t * 1000u / SIM_CYC_PER_US;
+    uint64_t now  = host_ns();
+
+    if (want > now + 1000000u)
+    {
+        struct timespec ts;
+        uint64_t        d = want - now;
+
+        ts.tv_sec  = (time_t)(d / 1000000000u);
+        ts.tv_nsec = (long)(d % 1000000000u);
+        nanosleep(&ts, NULL);
+    }
+}
+
+static void set_now(uint64_t t)
+{
+    if (stopReq)
+        sim_finish();
+    if (t <= simNow)
+        return;
+    if (simRealtime)
+        pace(t);
+    if ((simCoreDebug.DEMCR & CoreDebug_DEMCR_TRCENA_Msk) &&
+        (simDwt.CTRL & DWT_CTRL_CYCCNTENA_Msk) && !parked)
+        simDwt.CYCCNT += (uint32_t)(t - simNow);
+    simNow = t;
+    if (simNow >= simEnd)
+        sim_finish();
+
+    /* host UART bytes only become RX events when polled */
+    if (simNow >= nextPoll)
+    {
+        nextPoll = simNow + SIM_HZ / 1000u;
+        hal_poll_input();
+    }
+}
+
+
+static int masked(const sim_irq_t *s)
+{
+    if (simPrimask)
+        return 1;
+    return (simBasepri != 0u) && (((uint32_t)s->prio << SIM_PRIO_SHIFT) >= simBasepri);
+}
+
+static uint64_t next_due(uint8_t enabledOnly)
+{
+    uint64_t t = SIM_NEVER;
+    uint8_t  i;
+
+    for (i = 0u; i < SIM_IRQ_COUNT; i++)
+    {
+        if (enabledOnly && !simIrq[i].enabled)
+            continue;
+        if (simIrq[i].next < t)
+            t = simIrq[i].next;
+    }
+    return t;
+}
+
+/* everything due by now: peripheral side, reload, pend */
+static void latch(void)
+{
+    uint8_t i;
+
+    for (i = 0u; i < SIM_IRQ_COUNT; i++)
+    {
+        sim_irq_t *s = &simIrq[i];
+
+        if (s->next > simNow)
+            continue;
+        s->next = s->period ? s->next + s->period : SIM_NEVER;
+        if ((s->due == NULL) || s->due())
+            s->pending = 1u;
+    }
+}
+
+static void run(uint8_t i)
+{
+    sim_irq_t *s  = &simIrq[i];
+    uint64_t   t0 = host_ns();
+
+    activeIrq = (i == SIM_IRQ_SYSTICK) ? 15u : 16u + i;
+    s->vector();
+    activeIrq = 0u;
+    s->runs++;
+    s->hostNs += host_ns() - t0;
+}
+
+/* =========================================================
+ *  public API
+ * =======================================================*/
+void sim_schedule(uint8_t irq, uint64_t at, uint64_t period)
+{
+    simIrq[irq].next   = at;
+    simIrq[irq].period = period;
+}
+
+void sim_dispatch(void)
+{
+    if (activeIrq)
+        return;             /* vectors do not nest: nothing in them waits */
+
+    for (;;)
+    {
+        uint8_t best = SIM_IRQ_COUNT;
+        uint8_t i;
+
+        for (i = 0u; i < SIM_IRQ_COUNT; i++)
+        {
+            const sim_irq_t *s = &simIrq[i];
+
+            if (!s->pending || !s->enabled || (s->vector == NULL) || masked(s))
+                continue;
+            if ((best == SIM_IRQ_COUNT) || (s->prio < simIrq[best].prio))
+                best = i;
+        }
+        if (best == SIM_IRQ_COUNT)
+            break;
+        simIrq[best].pending = 0u;
+        run(best);
+    }
+    vPortSwitchIfPending();
+}
+
+void sim_advance_to(uint64_t t)
+{
+    if (wallStart == 0u)
+    {
+        wallStart = host_ns();
+        signal(SIGINT, on_sigint);
+    }
+
+    for (;;)
+    {
+        uint64_t d;
+
+        sim_dispatch();
+        d = next_due(0u);
+        if (d > t)
+            break;
+        set_now(d);
+        latch();
+    }
+    set_now(t);
+}
+
+void sim_delay(uint64_t cycles)
+{
+    sim_advance_to(simNow + cycles);
+}
+
+/* a millisecond at a time, so host UART input can end the wait */
+void sim_wfi(void)
+{
+    for (;;)
+    {
+        uint64_t t    = next_due(1u);
+        uint64_t step = simNow + SIM_HZ / 1000u;
+
+        if (t <= step)
+        {
+            sim_advance_to(t);
+            return;
+        }
+        sim_advance_to(step);
+    }
+}
+
+void sim_park(void)
+{
+    parked = 1u;
+    sim_wfi();
+    parked = 0u;
+}
+
+uint32_t sim_active_irq(void)
+{
+    return activeIrq;
+}
+
+uint32_t __get_IPSR(void)
+{
+    return activeIrq;
+}
+
+void sim_assert_failed(const char *file, int line)
+{
+    fprintf(stderr, "sim: configASSERT failed at %s:%d, t=%llu\n", file, line,
+            (unsigned long long)simNow);
+    abort();
+}
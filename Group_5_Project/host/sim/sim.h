@@ -0,0 +1,103 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+/* ---------- virtual time and simulated interrupts ----------
+ * Time is in CPU cycles at BCLK and only moves when the firmware
+ * waits: busy waits in the HAL (UART TX, CyDelayUs, ADC end of
+ * conversion) and the idle task. Firmware code itself takes no time,
+ * so a run is deterministic for a given input. Each interrupt source
+ * is a periodic or one-shot event; when it comes due it is pended,
+ * and runs on the current task thread as soon as the masks allow.
+ */
+#define SIM_HZ             24000000u
+#define SIM_CYC_PER_US     (SIM_HZ / 1000000u)
+
+/* sources; 0..4 are the NVIC numbers in project.h */
+#define SIM_IRQ_SAR1       0u
+#define SIM_IRQ_SAR2       1u
+#define SIM_IRQ_UART       2u
+#define SIM_IRQ_SCOPE      3u
+#define SIM_IRQ_WAVE       4u
+#define SIM_IRQ_SYSTICK    5u
+#define SIM_IRQ_COUNT      6u
+
+#define SIM_NEVER          UINT64_MAX
+
+typedef struct
+{
+    const char *name;
+    void      (*vector)(void);
+    uint8_t   (*due)(void);      /* peripheral side of the event; 0: no interrupt */
+    uint64_t    next;            /* cycle it comes due, SIM_NEVER if idle */
+    uint64_t    period;          /* 0: one shot */
+    uint8_t     prio;            /* NVIC priority, 0 most urgent */
+    uint8_t     enabled;
+    uint8_t     pending;
+    uint64_t    runs;
+    uint64_t    hostNs;          /* host time spent in the vector */
+} sim_irq_t;
+
+extern sim_irq_t simIrq[SIM_IRQ_COUNT];
+extern uint64_t  simNow;
+
+/* BASEPRI as the port sets it (0: open) and PRIMASK */
+extern uint32_t  simBasepri;
+extern uint8_t   simPrimask;
+
+void     sim_schedule(uint8_t irq, uint64_t at, uint64_t period);
+
+/* busy wait: advance to t, running interrupts on the way */
+void     sim_advance_to(uint64_t t);
+void     sim_delay(uint64_t cycles);
+
+/* sleep until the next enabled interrupt comes due */
+void     sim_wfi(void);
+
+/* the same with the core halted (WFI, Alternate Active, Sleep): DWT
+ * does not count, SysTick does */
+void     sim_park(void);
+
+/* run pending interrupts the masks allow, then any switch they asked for */
+void     sim_dispatch(void);
+uint32_t sim_active_irq(void);
+
+/* ---------- run control (sim_main.c) ---------- */
+extern uint64_t simEnd;            /* stop here, SIM_NEVER: run on */
+extern uint64_t simEofGrace;       /* on RX end of file, stop this much later */
+extern uint8_t  simRealtime;       /* pace virtual time to the wall clock */
+void     sim_finish(void);
+
+/* ---------- host side of the peripherals (hal.c) ---------- */
+#define HAL_SCOPE_VDAC     0u      /* VDAC8_1 looped back to the scope pin */
+#define HAL_SCOPE_SINE     1u
+#define HAL_SCOPE_FILE     2u      /* recorded mV, one per conversion, looped */
+
+typedef struct
+{
+    uint8_t     scope;
+    double      sineHz, sineMvpp, sineOffMv;
+    double     *fileMv;
+    size_t      fileLen;
+    double      noiseMv;           /* uniform, +- this, on both ADCs */
+    double      dutR;              /* ohms on Pin_R, 0: open */
+    double      dutC;              /* farads on Pin_C */
+    double      dutLeakR;          /* ohms across it, 0: none */
+    const char *eepromPath;        /* keeps the calibration between runs */
+    const char *vdacPath;          /* VDAC8_1 writes, <u64 cycle, u8 code> LE */
+} hal_cfg_t;
+
+extern hal_cfg_t halCfg;
+
+void     hal_init(void);
+void     hal_report(FILE *f);
+void     hal_poll_input(void);     /* host RX bytes into the UART */
+extern int      halRxFd, halTxFd;  /* UART bridge */
+extern uint8_t  halRxEof;
+
+/* ---------- host side of the port (port.c) ---------- */
+void     vPortSwitchIfPending(void);
+
+#endif /* SIM_H */
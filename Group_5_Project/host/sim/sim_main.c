@@ -0,0 +1,207 @@
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "sim.h"
+
+/* ---------- fwsim: the firmware on a simulated PSoC ----------
+ * main.c is built with main renamed to firmware_main; this main sets
+ * up the UART bridge and the signal sources, then hands over.
+ */
+int firmware_main(void);
+
+uint64_t simEnd      = SIM_NEVER;
+uint64_t simEofGrace;
+uint8_t  simRealtime;
+
+static uint64_t wallT0;
+
+static const char usage[] =
+    "usage: fwsim [options]\n"
+    "  --pty             UART on a new pty, its path on stderr (default)\n"
+    "  --stdio           UART on stdin/stdout; stop 1 s after stdin ends\n"
+    "  --realtime        pace to the wall clock (default with --pty)\n"
+    "  --fast            run as fast as the host can (default with --stdio)\n"
+    "  --time S          stop after S simulated seconds\n"
+    "  --scope vdac      scope input is the generator output (default)\n"
+    "  --scope sine:HZ:MVPP:MVOFF\n"
+    "  --scope file:PATH one mV value per line, one per conversion, looped\n"
+    "  --noise MV        uniform noise on both ADCs, +-MV\n"
+    "  --dut-r OHMS      resistor on Pin_R, 0 for open (default 1000)\n"
+    "  --dut-c FARADS    capacitor on Pin_C (default 100e-9)\n"
+    "  --dut-leak OHMS   resistor across it, 0 for none\n"
+    "  --eeprom PATH     keep the emulated EEPROM in this file\n"
+    "  --vdac-out PATH   record VDAC8_1 writes, <u64 cycle, u8 code> LE\n";
+
+static uint64_t wall_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void die(const char *msg, const char *arg)
+{
+    fprintf(stderr, "fwsim: %s%s\n%s", msg, arg ? arg : "", usage);
+    exit(2);
+}
+
+static void load_scope_file(const char *path)
+{
+    FILE  *f = fopen(path, "r");
+    size_t cap = 1024u;
+    double v;
+
+    if (f == NULL)
+        die("cannot read ", path);
+    halCfg.fileMv  = malloc(cap * sizeof(double));
+    halCfg.fileLen = 0u;
+    while (fscanf(f, "%lf", &v) == 1)
+    {
+        if (halCfg.fileLen == cap)
+        {
+            cap *= 2u;
+            halCfg.fileMv = realloc(halCfg.fileMv, cap * sizeof(double));
+        }
+        halCfg.fileMv[halCfg.fileLen++] = v;
+    }
+    fclose(f);
+    if (halCfg.fileLen == 0u)
+        die("no samples in ", path);
+    halCfg.scope = HAL_SCOPE_FILE;
+}
+
+static void parse_scope(const char *arg)
+{
+    if (strcmp(arg, "vdac") == 0)
+        halCfg.scope = HAL_SCOPE_VDAC;
+    else if (strncmp(arg, "file:", 5u) == 0)
+        load_scope_file(arg + 5);
+    else if (sscanf(arg, "sine:%lf:%lf:%lf", &halCfg.sineHz, &halCfg.sineMvpp,
+                    &halCfg.sineOffMv) == 3)
+        halCfg.scope = HAL_SCOPE_SINE;
+    else
+        die("bad --scope ", arg);
+}
+
+static void open_pty(void)
+{
+    struct termios tio;
+    int fd = posix_openpt(O_RDWR | O_NOCTTY);
+    int slave;
+
+    if ((fd < 0) || (grantpt(fd) != 0) || (unlockpt(fd) != 0))
+        die("cannot open a pty", NULL);
+    fcntl(fd, F_SETFL, O_NONBLOCK);
+
+    /* hold the slave open so the master never sees a hangup between
+     * host sessions, and raw so the line discipline neither echoes
+     * the firmware's output back at it nor rewrites CR/LF */
+    slave = open(ptsname(fd), O_RDWR | O_NOCTTY);
+    if (slave < 0)
+        die("cannot open ", ptsname(fd));
+    if (tcgetattr(slave, &tio) == 0)
+    {
+        cfmakeraw(&tio);
+        tcsetattr(slave, TCSANOW, &tio);
+    }
+    fprintf(stderr, "fwsim: UART on %s\n", ptsname(fd));
+    halRxFd = fd;
+    halTxFd = fd;
+}
+
+void sim_finish(void)
+{
+    double  simS  = (double)simNow / SIM_HZ;
+    double  wallS = (double)(wall_ns() - wallT0) / 1e9;
+    uint8_t i;
+
+    fprintf(stderr, "\n--- fwsim ---\n");
+    fprintf(stderr, "simulated %.3f s in %.3f s wall (x%.2f)\n", simS, wallS,
+            (wallS > 0.0) ? simS / wallS : 0.0);
+    for (i = 0u; i < SIM_IRQ_COUNT; i++)
+    {
+        const sim_irq_t *s = &simIrq[i];
+
+        fprintf(stderr, "%-14s %10llu runs  %8.1f ns/run host\n", s->name,
+                (unsigned long long)s->runs,
+                s->runs ? (double)s->hostNs / (double)s->runs : 0.0);
+    }
+    hal_report(stderr);
+    fflush(stdout);
+    fflush(stderr);
+    _exit(0);
+}
+
+int main(int argc, char **argv)
+{
+    uint8_t useStdio = 0u;
+    int     pace = -1;
+    int     i;
+
+    for (i = 1; i < argc; i++)
+    {
+        const char *a   = argv[i];
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(a, "--pty") == 0)
+            useStdio = 0u;
+        else if (strcmp(a, "--stdio") == 0)
+            useStdio = 1u;
+        else if (strcmp(a, "--realtime") == 0)
+            pace = 1;
+        else if (strcmp(a, "--fast") == 0)
+            pace = 0;
+        else if ((strcmp(a, "-h") == 0) || (strcmp(a, "--help") == 0))
+        {
+            fputs(usage, stdout);
+            return 0;
+        }
+        else if (val == NULL)
+            die("unknown option or missing value: ", a);
+        else
+        {
+            i++;
+            if (strcmp(a, "--time") == 0)
+                simEnd = (uint64_t)(atof(val) * SIM_HZ);
+            else if (strcmp(a, "--scope") == 0)
+                parse_scope(val);
+            else if (strcmp(a, "--noise") == 0)
+                halCfg.noiseMv = atof(val);
+            else if (strcmp(a, "--dut-r") == 0)
+                halCfg.dutR = atof(val);
+            else if (strcmp(a, "--dut-c") == 0)
+                halCfg.dutC = atof(val);
+            else if (strcmp(a, "--dut-leak") == 0)
+                halCfg.dutLeakR = atof(val);
+            else if (strcmp(a, "--eeprom") == 0)
+                halCfg.eepromPath = val;
+            else if (strcmp(a, "--vdac-out") == 0)
+                halCfg.vdacPath = val;
+            else
+                die("unknown option ", a);
+        }
+    }
+
+    if (useStdio)
+    {
+        fcntl(STDIN_FILENO, F_SETFL, fcntl(STDIN_FILENO, F_GETFL) | O_NONBLOCK);
+        halRxFd     = STDIN_FILENO;
+        halTxFd     = STDOUT_FILENO;
+        simEofGrace = SIM_HZ;
+    }
+    else
+    {
+        open_pty();
+    }
+    simRealtime = (pace < 0) ? !useStdio : (uint8_t)pace;
+
+    wallT0 = wall_ns();
+    hal_init();
+    firmware_main();
+    return 0;
+}
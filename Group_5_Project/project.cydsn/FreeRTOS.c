@@ -1,5 +1,6 @@
 #include <project.h>
 #include "FreeRTOS.h"
+#include "task.h"
 
 extern void xPortPendSVHandler(void);
 extern void xPortSysTickHandler(void);
@@ -20,4 +21,28 @@ void FreeRTOS_Start(){
     /* Handler for Cortex SYSTICK - address 15 */
 	CyIntSetSysVector( CORTEX_INTERRUPT_BASE + SysTick_IRQn,
         (cyisraddress)xPortSysTickHandler );
-}
\ No newline at end of file
+}
+
+/* configSUPPORT_STATIC_ALLOCATION: the kernel asks for the idle task's
+ * TCB and stack here */
+void vApplicationGetIdleTaskMemory(StaticTask_t **tcb, StackType_t **stack,
+                                   uint32_t *depth)
+{
+    static StaticTask_t idleTcb;
+    static StackType_t  idleStack[configMINIMAL_STACK_SIZE];
+
+    *tcb   = &idleTcb;
+    *stack = idleStack;
+    *depth = configMINIMAL_STACK_SIZE;
+}
+
+/* configCHECK_FOR_STACK_OVERFLOW: stop where a debugger can see it */
+void vApplicationStackOverflowHook(TaskHandle_t task, char *name)
+{
+    (void)task;
+    (void)name;
+    taskDISABLE_INTERRUPTS();
+    for (;;)
+    {
+    }
+}
@@ -0,0 +1,194 @@
+#include <project.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "cy_em_eeprom.h"
+#include "calib.h"
+
+/* cy_em_eeprom.c/.h come from the Em_EEPROM_Dynamic component (2.20),
+ * generated into Generated_Source/PSoC5 and built with the project
+ * (project.cyprj); host/sim/cy_em_eeprom.h stands in for the header */
+#if (CY_EM_EEPROM_VERSION_MAJOR != 2)
+    #error "calib.c is written against the Em_EEPROM 2.x Cy_Em_EEPROM_* API"
+#endif
+
+#define CAL_MAGIC          (0xCA1Bu)
+#define CAL_VERSION        (1u)
+
+/* cy_em_eeprom wants the data size to be a multiple of half a row */
+#define CAL_EE_SIZE        (CY_EM_EEPROM_EEPROM_DATA_LEN)
+#define CAL_EE_PHYS_SIZE   (CY_EM_EEPROM_GET_PHYSICAL_SIZE(CAL_EE_SIZE, 1u, 0u))
+
+/* entries that take reference points: R ranges, then C */
+#define CAL_ENTRIES        (R_RANGE_COUNT + 1u)
+
+/* storage in user flash, row aligned */
+CY_ALIGN(CY_EM_EEPROM_FLASH_SIZEOF_ROW)
+static const uint8 calStore[CAL_EE_PHYS_SIZE] = { 0u };
+
+static cy_stc_eeprom_context_t eeCtx;
+static uint8 eeOk;
+static uint8 fromEeprom;
+
+static cal_table_t cal;
+
+/* last two reference points per entry, for the two-point fit */
+typedef struct
+{
+    int32 raw[2];
+    int32 ref[2];
+    uint8 n;
+} cal_pts_t;
+
+static cal_pts_t pts[CAL_ENTRIES];
+
+/* =========================================================
+ *  helpers
+ * =======================================================*/
+static uint16 crc16_ccitt(const uint8 *p, uint32 len)
+{
+    uint16 crc = 0xFFFFu;
+    uint8  i;
+
+    while (len--)
+    {
+        crc ^= (uint16)(*p++) << 8;
+        for (i = 0u; i < 8u; i++)
+            crc = (crc & 0x8000u) ? (uint16)((crc << 1) ^ 0x1021u) : (uint16)(crc << 1);
+    }
+    return crc;
+}
+
+static uint16 table_crc(const cal_table_t *t)
+{
+    return crc16_ccitt((const uint8 *)t, offsetof(cal_table_t, crc));
+}
+
+static void set_defaults(void)
+{
+    uint8 i;
+
+    memset(&cal, 0, sizeof(cal));
+    cal.magic   = CAL_MAGIC;
+    cal.version = CAL_VERSION;
+    for (i = 0u; i < R_RANGE_COUNT; i++)
+        cal.r[i].gain_q16 = CAL_ONE_Q16;
+    /* 32 uA: the old single-range constants (code 50, "~414 uA" x 68)
+     * put the effective current at 6.09 uA against 6.25 uA nominal */
+    cal.r[R_RANGE_32UA].gain_q16 = 67306;   /* 1.027 */
+    cal.c.gain_q16      = CAL_ONE_Q16;
+    cal.scope_gain_ppm  = 1000000;
+    cal.crc = table_crc(&cal);
+
+    memset(pts, 0, sizeof(pts));
+}
+
+/* =========================================================
+ *  public API
+ * =======================================================*/
+void calib_load(void)
+{
+    cy_stc_eeprom_config_t cfg;
+    cal_table_t t;
+
+    set_defaults();
+    fromEeprom = 0u;
+
+    cfg.eepromSize         = CAL_EE_SIZE;
+    cfg.wearLevelingFactor = 1u;
+    cfg.redundantCopy      = 0u;
+    cfg.blockingWrite      = 1u;
+    cfg.userFlashStartAddr = (uint32)(uintptr_t)calStore;
+    eeOk = (Cy_Em_EEPROM_Init(&cfg, &eeCtx) == CY_EM_EEPROM_SUCCESS) ? 1u : 0u;
+    if (!eeOk)
+        return;
+
+    /* a plain copy out of flash, well under a millisecond */
+    if (Cy_Em_EEPROM_Read(0u, &t, sizeof(t), &eeCtx) != CY_EM_EEPROM_SUCCESS)
+        return;
+    if ((t.magic != CAL_MAGIC) || (t.version != CAL_VERSION) ||
+        (t.crc != table_crc(&t)))
+        return;
+
+    cal = t;
+    fromEeprom = 1u;
+}
+
+uint8 calib_from_eeprom(void)
+{
+    return fromEeprom;
+}
+
+const cal_table_t *calib_table(void)
+{
+    return &cal;
+}
+
+const cal_lin_t *calib_add_point(uint8 kind, uint8 range, int32 raw, int32 ref)
+{
+    uint8      e = (kind == MEAS_C) ? R_RANGE_COUNT : range;
+    cal_lin_t *c;
+    cal_pts_t *p;
+
+    if (e >= CAL_ENTRIES)
+        return &cal.c;
+    c = (kind == MEAS_C) ? &cal.c : &cal.r[e];
+    p = &pts[e];
+
+    /* keep the newest two; the same raw value again replaces it */
+    if (p->n == 2u)
+    {
+        p->raw[0] = p->raw[1];
+        p->ref[0] = p->ref[1];
+        p->n = 1u;
+    }
+    if (p->n == 1u && p->raw[0] == raw)
+        p->n = 0u;
+    p->raw[p->n] = raw;
+    p->ref[p->n] = ref;
+    p->n++;
+
+    if (p->n == 1u)
+    {
+        if (raw > 0)
+        {
+            c->gain_q16 = (int32)(((int64)ref << 16) / raw);
+            c->offset   = 0;
+        }
+    }
+    else
+    {
+        int32 draw = p->raw[1] - p->raw[0];
+        c->gain_q16 = (int32)(((int64)(p->ref[1] - p->ref[0]) << 16) / draw);
+        c->offset   = p->ref[0] - (int32)(((int64)p->raw[0] * c->gain_q16) >> 16);
+    }
+    cal.crc = table_crc(&cal);
+    return c;
+}
+
+void calib_set_scope_ppm(int32 ppm)
+{
+    cal.scope_gain_ppm = ppm;
+    cal.crc = table_crc(&cal);
+}
+
+void calib_reset(void)
+{
+    set_defaults();
+}
+
+uint8 calib_save(void)
+{
+    uint8 buf[CAL_EE_SIZE];
+
+    if (!eeOk)
+        return 0u;
+
+    memset(buf, 0, sizeof(buf));
+    cal.crc = table_crc(&cal);
+    memcpy(buf, &cal, sizeof(cal));
+    if (Cy_Em_EEPROM_Write(0u, buf, sizeof(buf), &eeCtx) != CY_EM_EEPROM_SUCCESS)
+        return 0u;
+    fromEeprom = 1u;
+    return 1u;
+}
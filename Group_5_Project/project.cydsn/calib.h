@@ -0,0 +1,54 @@
+#ifndef CALIB_H
+#define CALIB_H
+
+#include <cytypes.h>
+#include "meter.h"
+
+/* ---------- meter / scope calibration ----------
+ * Lives in RAM while running; a copy with a CRC is kept in emulated
+ * EEPROM (cy_em_eeprom, one flash row) and loaded at boot.
+ */
+#define CAL_ONE_Q16        65536
+
+/* y = x * gain_q16 / 65536 + offset */
+typedef struct
+{
+    int32 gain_q16;
+    int32 offset;
+} cal_lin_t;
+
+typedef struct
+{
+    uint16    magic;
+    uint16    version;
+    cal_lin_t r[R_RANGE_COUNT];   /* raw ohms -> ohms, per range */
+    cal_lin_t c;                  /* raw pF -> pF */
+    int32     scope_gain_ppm;     /* applied by the host to scope frames */
+    uint16    reserved;
+    uint16    crc;                /* CRC-16/CCITT of everything above */
+} cal_table_t;
+
+/* boot: EEPROM -> RAM, falls back to defaults if the copy is bad */
+void  calib_load(void);
+uint8 calib_from_eeprom(void);
+
+/* the table in use */
+const cal_table_t *calib_table(void);
+
+static inline int32 cal_apply(const cal_lin_t *c, int32 x)
+{
+    return (int32)(((int64)x * c->gain_q16) >> 16) + c->offset;
+}
+
+/* reference part of value ref read as raw (MEAS_R: range picks the
+ * entry, ohms; MEAS_C: pF). One point sets a pure gain, a second
+ * point on the same entry fits gain and offset. Returns the entry. */
+const cal_lin_t *calib_add_point(uint8 kind, uint8 range, int32 raw, int32 ref);
+
+void  calib_set_scope_ppm(int32 ppm);
+void  calib_reset(void);
+
+/* RAM -> EEPROM; blocks for the flash row write. 0 on error. */
+uint8 calib_save(void);
+
+#endif /* CALIB_H */
@@ -0,0 +1,24 @@
+#ifndef CPU_CYCLES_H
+#define CPU_CYCLES_H
+
+#include <project.h>
+
+/* ---------- DWT cycle counter ----------
+ * CPU runs off the bus clock; CYCCNT wraps every ~179 s at 24 MHz,
+ * so unsigned differences are fine for anything shorter than that.
+ */
+#define CYCLES_PER_US      (BCLK__BUS_CLK__MHZ)
+
+static inline void cycles_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0u;
+    DWT->CTRL  |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static inline uint32 cycles_now(void)
+{
+    return DWT->CYCCNT;
+}
+
+#endif /* CPU_CYCLES_H */
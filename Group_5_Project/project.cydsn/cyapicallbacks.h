@@ -16,6 +16,14 @@
     /*Define your macro callbacks here */
     /*For more information, refer to the Writing Code topic in the PSoC Creator Help.*/
 
+    /* meter.c: C capture runs off the ADC_SAR_2 end-of-conversion IRQ */
+    #define ADC_SAR_2_ISR_INTERRUPT_CALLBACK
+    void ADC_SAR_2_ISR_InterruptCallback(void);
+
+    /* main.c: UART RX bytes into the command stream buffer */
+    #define UART_RXISR_EXIT_CALLBACK
+    void UART_RXISR_ExitCallback(void);
+
     
 #endif /* CYAPICALLBACKS_H */   
 /* [] */
@@ -0,0 +1,70 @@
+#include "fmt.h"
+
+char *fmt_str(char *p, const char *s)
+{
+    while (*s)
+        *p++ = *s++;
+    return p;
+}
+
+char *fmt_u32(char *p, uint32 v)
+{
+    char  tmp[10];
+    uint8 n = 0u;
+
+    do
+    {
+        tmp[n++] = (char)('0' + (v % 10u));
+        v /= 10u;
+    } while (v);
+
+    while (n)
+        *p++ = tmp[--n];
+    return p;
+}
+
+char *fmt_i32(char *p, int32 v)
+{
+    if (v < 0)
+    {
+        *p++ = '-';
+        return fmt_u32(p, (uint32)0 - (uint32)v);
+    }
+    return fmt_u32(p, (uint32)v);
+}
+
+char *fmt_fix(char *p, int32 v, uint8 dp)
+{
+    uint32 a, scale = 1u;
+    uint8  i;
+
+    for (i = 0u; i < dp; i++)
+        scale *= 10u;
+
+    if (v < 0)
+    {
+        *p++ = '-';
+        a = (uint32)0 - (uint32)v;
+    }
+    else
+        a = (uint32)v;
+
+    p = fmt_u32(p, a / scale);
+    if (dp == 0u)
+        return p;
+
+    *p++ = '.';
+    a %= scale;
+    /* leading zeros of the fraction */
+    for (scale /= 10u; scale > 1u && a < scale; scale /= 10u)
+        *p++ = '0';
+    return fmt_u32(p, a);
+}
+
+char *fmt_eol(char *p)
+{
+    *p++ = '\r';
+    *p++ = '\n';
+    *p   = '\0';
+    return p;
+}
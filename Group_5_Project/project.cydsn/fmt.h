@@ -0,0 +1,21 @@
+#ifndef FMT_H
+#define FMT_H
+
+#include <cytypes.h>
+
+/* ---------- integer text formatting ----------
+ * Stands in for sprintf on the UART text protocol: no float, no
+ * varargs, a few words of stack. Each call appends at p and returns
+ * the new end; fmt_eol closes the line with CR LF and a NUL.
+ * The caller sizes the buffer (11 chars covers any int32).
+ */
+char *fmt_str(char *p, const char *s);
+char *fmt_u32(char *p, uint32 v);
+char *fmt_i32(char *p, int32 v);
+
+/* v / 10^dp with exactly dp decimals, e.g. (1234, 3) -> "1.234" */
+char *fmt_fix(char *p, int32 v, uint8 dp);
+
+char *fmt_eol(char *p);
+
+#endif /* FMT_H */
@@ -0,0 +1,45 @@
+#ifndef IRQ_PRIO_H
+#define IRQ_PRIO_H
+
+#include <project.h>
+#include "FreeRTOS.h"
+
+/* ---------- interrupt priority plan ----------
+ * cyfitter puts every interrupt at 7, the kernel's own level, so the
+ * generator step waited behind the scope ISR and every kernel critical
+ * section. 0 is the most urgent; configMAX_SYSCALL_INTERRUPT_PRIORITY
+ * (5) is the ceiling that taskENTER_CRITICAL masks up to.
+ *   2  isr_wave       above the ceiling: only PRIMASK (CyEnterCritical-
+ *                     Section) holds it off. Must not call FreeRTOS or LOG().
+ *   5  UART RX        4-byte FIFO, the tightest deadline that needs
+ *                     the kernel (xStreamBufferSendFromISR)
+ *   6  isr_adc        scope sample, notifies scopeTask
+ *   6  ADC_SAR_2_IRQ  meter capture, notifies measTask
+ *   7  kernel         SysTick / PendSV
+ * Applied once after the components are started, since their Start()
+ * loads the cyfitter value.
+ */
+#define IRQ_PRIO_WAVE      2u
+#define IRQ_PRIO_UART      5u
+#define IRQ_PRIO_SCOPE     6u
+#define IRQ_PRIO_METER     6u
+
+#define IRQ_PRIO_CEILING   (configMAX_SYSCALL_INTERRUPT_PRIORITY >> (8u - configPRIO_BITS))
+
+#if (IRQ_PRIO_WAVE >= IRQ_PRIO_CEILING)
+    #error "isr_wave must sit above the syscall ceiling"
+#endif
+#if (IRQ_PRIO_UART < IRQ_PRIO_CEILING) || (IRQ_PRIO_SCOPE < IRQ_PRIO_CEILING) || \
+    (IRQ_PRIO_METER < IRQ_PRIO_CEILING)
+    #error "ISRs that use FreeRTOS must sit at or below the syscall ceiling"
+#endif
+
+static inline void irq_prio_apply(void)
+{
+    isr_wave_SetPriority(IRQ_PRIO_WAVE);
+    CyIntSetPriority(UART_RX_VECT_NUM, IRQ_PRIO_UART);
+    isr_adc_SetPriority(IRQ_PRIO_SCOPE);
+    ADC_SAR_2_IRQ_SetPriority(IRQ_PRIO_METER);
+}
+
+#endif /* IRQ_PRIO_H */
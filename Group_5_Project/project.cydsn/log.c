@@ -0,0 +1,121 @@
+#include <project.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "log.h"
+#include "tx.h"
+
+/* power of two; each slot is 32 bytes */
+#define LOG_SLOTS          32u
+
+/* a slot is free for ticket t when seq == t, holds record t when
+ * seq == t + 1, and is handed back as t + LOG_SLOTS */
+typedef struct
+{
+    volatile uint32_t seq;
+    uint32            t_ms;
+    uint8             id;
+    uint8             n;
+    int32             arg[LOG_MAX_ARGS];
+} log_slot_t;
+
+static log_slot_t        ring[LOG_SLOTS];
+static volatile uint32_t head;        /* next ticket, producers */
+static uint32_t          tail;        /* next record, TX task only */
+static volatile uint32_t drops;
+
+static void atomic_inc(volatile uint32_t *p)
+{
+    while (__STREXW(__LDREXW(p) + 1u, p))
+    {
+    }
+}
+
+/* =========================================================
+ *  public API
+ * =======================================================*/
+void log_write(uint8 id, uint8 n, const int32 *args)
+{
+    log_slot_t *s;
+    uint32_t    t;
+    uint8       i;
+
+    if (n > LOG_MAX_ARGS)
+        n = LOG_MAX_ARGS;
+
+    /* take a ticket; an interrupt in between clears the exclusive
+     * monitor and the STREX fails, so just go round again */
+    for (;;)
+    {
+        t = __LDREXW(&head);
+        s = &ring[t & (LOG_SLOTS - 1u)];
+        if (s->seq != t)
+        {
+            __CLREX();
+            atomic_inc(&drops);
+            return;
+        }
+        if (__STREXW(t + 1u, &head) == 0u)
+            break;
+    }
+
+    s->t_ms = (uint32)xTaskGetTickCountFromISR();
+    s->id   = id;
+    s->n    = n;
+    for (i = 0u; i < n; i++)
+        s->arg[i] = args[i];
+    __DMB();
+    s->seq = t + 1u;
+
+    tx_kick();
+}
+
+void log_start(void)
+{
+    uint32 i;
+
+    for (i = 0u; i < LOG_SLOTS; i++)
+        ring[i].seq = i;
+}
+
+uint8 log_pending(void)
+{
+    return (ring[tail & (LOG_SLOTS - 1u)].seq == tail + 1u) ? 1u : 0u;
+}
+
+static uint8 *put_le32(uint8 *p, uint32 v)
+{
+    p[0] = (uint8)v;
+    p[1] = (uint8)(v >> 8);
+    p[2] = (uint8)(v >> 16);
+    p[3] = (uint8)(v >> 24);
+    return p + 4;
+}
+
+uint8 log_take(uint8 *out)
+{
+    log_slot_t *s;
+    uint8      *p = out;
+    uint8       i;
+
+    if (!log_pending())
+        return 0u;
+    s = &ring[tail & (LOG_SLOTS - 1u)];
+    __DMB();
+
+    *p++ = LOG_MARK;
+    *p++ = (uint8)(5u + 4u * s->n);
+    *p++ = s->id;
+    p = put_le32(p, s->t_ms);
+    for (i = 0u; i < s->n; i++)
+        p = put_le32(p, (uint32)s->arg[i]);
+
+    __DMB();
+    s->seq = tail + LOG_SLOTS;
+    tail++;
+    return (uint8)(p - out);
+}
+
+uint32 log_dropped(void)
+{
+    return drops;
+}
@@ -0,0 +1,39 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <cytypes.h>
+#include "log_fmt.h"
+
+/* ---------- tokenized logging ----------
+ * A record is a format id (log_fmt.h), the tick time and up to
+ * LOG_MAX_ARGS raw int32 arguments; nothing is formatted on the
+ * target. log_write reserves a ring slot lock-free (LDREX/STREX), so
+ * any task or ISR at or below the syscall ceiling may log; a full ring
+ * drops the record and counts it. The TX task drains the ring as the
+ * TX_CH_DEBUG class:
+ *   0xAD | len u8 | id u8 | t_ms u32 | args i32 x n, little endian
+ */
+#define LOG_MARK           0xADu
+#define LOG_MAX_ARGS       5u
+#define LOG_REC_MAX        (2u + 5u + 4u * LOG_MAX_ARGS)
+
+/* empties the ring; before the first ISR that logs is enabled */
+void   log_start(void);
+
+void   log_write(uint8 id, uint8 n, const int32 *args);
+
+/* LOG(LOG_DBG_R, mv, range, ...): one to LOG_MAX_ARGS arguments */
+#define LOG(id, ...) \
+    do { \
+        const int32 logArgs_[] = { __VA_ARGS__ }; \
+        log_write((id), (uint8)(sizeof(logArgs_) / sizeof(logArgs_[0])), logArgs_); \
+    } while (0)
+
+/* TX task side: a record ready? encode it into out (LOG_REC_MAX) */
+uint8  log_pending(void);
+uint8  log_take(uint8 *out);
+
+/* records lost to a full ring since boot */
+uint32 log_dropped(void);
+
+#endif /* LOG_H */
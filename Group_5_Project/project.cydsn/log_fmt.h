@@ -0,0 +1,26 @@
+#ifndef LOG_FMT_H
+#define LOG_FMT_H
+
+/* ---------- log format table ----------
+ * One entry per record type: id, format. Only the ids are built into
+ * the firmware; the host renders the int32 arguments with the format.
+ * Python_Scripts/gen_log_table.py copies this list to log_table.py,
+ * so re-run it after any change here. Append only: the id is the
+ * position in the list.
+ */
+#define LOG_FORMATS(X) \
+    X(LOG_DBG_R,    "DBG_R: mv=%d, range=%d, code=%d, Rraw=%d, Rcal=%d") \
+    X(LOG_DBG_C,    "DBG_C: ok=%d, dt=%d ns, C=%d pF") \
+    X(LOG_DBG_D,    "DBG_D: mv=%d, mv_quarter=%d, code=%d") \
+    X(LOG_DBG_L,    "DBG_L: tau=%d ns, rdc=%d, vinf=%d mv") \
+    X(LOG_DBG_CFIT, "DBG_CFIT: span=%d ns, C=%d pF, leak=%d k, fit=%d")
+
+#define LOG_ENUM(id, fmt)  id,
+
+enum
+{
+    LOG_FORMATS(LOG_ENUM)
+    LOG_ID_COUNT
+};
+
+#endif /* LOG_FMT_H */
@@ -2,326 +2,403 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
-#include <stdio.h>
 #include "FreeRTOS.h"
 #include "task.h"
+#include "stream_buffer.h"
+#include "wavegen.h"
+#include "meter.h"
+#include "calib.h"
+#include "fmt.h"
+#include "cpu_cycles.h"
+#include "tx.h"
+#include "power.h"
+#include "stats.h"
+#include "log.h"
+#include "irq_prio.h"
 
 /* ---------- scope config ---------- */
-#define FRAME_SAMPLES      252u
+#define REC_DEFAULT_LEN    252u
+#define REC_MIN_LEN        64u
 #define ADC_TO_8BIT_SHIFT  4u
 #define DECIM_FACTOR       2u
 
-/* ---------- waveform generator ---------- */
-#define LUT_SIZE           128u
-#define WAVE_CLK_HZ        1000000u
+/* trigger sources */
+#define TRIG_FREE          0u
+#define TRIG_GEN           1u     /* generator phase wrap */
 
-/* ---------- R measurement ---------- */
-#define IDAC_R_CODE        (50u)
-/* effective IDAC current for this code (in Amps) */
-#define IDAC_R_CURRENT_A   (0.000414f)  /* ~414 µA, used for Rraw */
+/* auto-trigger: start anyway if no sync within this many ADC samples */
+#define TRIG_TIMEOUT_SAMPLES  (4u * REC_DEFAULT_LEN * DECIM_FACTOR)
 
-/* calibration gain: maps Rraw to real ohms.
- * from your logs: 3.3k -> Rraw ~50, 10k -> ~150 ⇒ factor ≈ 66
- */
-#define R_CAL_GAIN         (68.0f)
+#define AVG_MAX            256u
 
-/* ---------- C measurement ---------- */
-/* We measure in the small-signal region 2 mV .. 10 mV,
- * because the node never rises above ~15 mV due to internal loading.
- */
-#define IDAC_C_CODE        (12u)
-#define IDAC_C_LSB_A       (8e-6f)
-#define IDAC_C_CURRENT_A   (IDAC_C_CODE * IDAC_C_LSB_A)
-
-/* new thresholds in the reachable range */
-#define DISCHARGE_MS       (50u)
-#define SAMPLE_US          (10u)
-#define VSTART_MV          (2)
-#define VEND_MV            (10)
-#define TIMEOUT_MS         (500u)
+/* METER stream record: 0xAB, len, then
+ * kind u8 | status u8 (bit0 ok, bits1-2 R range) | seq u16 | t_ms u32 |
+ * value i32 (ohms / pF), little endian */
+#define METER_MARK         0xABu
+#define METER_REC_LEN      12u
 
+/* ---------- tasks ----------
+ * priorities by how late each may be: the scope handoff must free the
+ * frame before the next one is due, commands are answered as soon as
+ * their line is in, measurements run in between, and the TX task (tx.c,
+ * priority 1) spins on the UART with whatever time is left. A queued
+ * reply lifts TX above the measurement task until it is sent.
+ */
+#define SCOPE_TASK_STACK   (128u)
+#define SCOPE_TASK_PRIO    (4u)
+#define CMD_TASK_STACK     (256u)
+#define CMD_TASK_PRIO      (3u)
+/* UART RX: ISR -> stream buffer, sized for a scripted burst of
+ * full-length commands back to back */
+#define RX_STREAM_LEN      (1024u)
+
+/* scope record on the wire, SCOPE_CHUNK samples per message:
+ * 0xAA | rec u8 | total u16 | offset u16 | n u8 | n samples,
+ * little endian; rec counts records so a cut-off one is seen */
+#define FRAME_MARK         0xAAu
+#define FRAME_HDR_LEN      7u
+#define SCOPE_CHUNK        240u
+/* a chunk that cannot be queued this long abandons the record */
+#define SCOPE_CHUNK_WAIT_MS  (200u)
+
+/* readings averaged per CAL reference point */
+#define CAL_SHOTS          16u
+
+/* BENCH: passes over the sample results */
+#define BENCH_PASSES       16u
+
+/* BENCH_SPRINTF 1 (Preprocessor Definitions, with the linker's Enable
+ * Float printf back on) builds the sprintf/%f lines fmt.c replaced, and
+ * BENCH times them too; flash and stack costs come from the .map */
+#ifndef BENCH_SPRINTF
+#define BENCH_SPRINTF      0
+#endif
+#if BENCH_SPRINTF
+#include <stdio.h>
+#endif
+
+/* JITTER: intervals per run, and how often the command task polls */
+#define JITTER_DEFAULT_N   4096u
+#define JITTER_MAX_N       65535u
+#define JITTER_POLL_MS     10u
+
+/* ---------- acquisition memory ----------
+ * The SRAM the FreeRTOS heap used to hold (all kernel objects are
+ * static now). 8-bit samples fill it from the start; when averaging,
+ * the same words hold the 32-bit sums and finish_average folds them
+ * down in place, front to back (byte i never lies past sum i).
+ */
+#define SCOPE_MEM_BYTES    (32u * 1024u)
+#define REC_MAX_LEN        SCOPE_MEM_BYTES
+#define REC_MAX_AVG_LEN    (SCOPE_MEM_BYTES / 4u)   /* 32-bit sums */
 
-#define C_CAL_GAIN         (0.014f)   /* start with ~0.11, tweak if needed */
+static volatile uint32 scopeMem[SCOPE_MEM_BYTES / 4u];
 
 /* ---------- scope buffer ---------- */
-static volatile uint8  sampleBuffer[FRAME_SAMPLES];
+static volatile uint8 * const sampleBuffer = (volatile uint8 *)scopeMem;
 static volatile uint16 sampleIndex = 0u;
+static volatile uint16 recLen      = REC_DEFAULT_LEN;
 static volatile uint8  frameReady  = 0u;
 
-/* ---------- waveform LUTs ---------- */
-static uint8 sineBase[LUT_SIZE];
-static uint8 triBase[LUT_SIZE];
-static uint8 sqrBase[LUT_SIZE];
-static uint8 waveLUT[LUT_SIZE];
+/* ---------- generator-synchronous trigger ---------- */
+#define TRIG_IDLE          0u
+#define TRIG_ARM           1u     /* snapshot sync count on next sample */
+#define TRIG_WAIT          2u     /* waiting for it to change */
 
-static volatile uint16 waveIndex    = 0u;
-static volatile uint8  waveMode     = 0u;   /* 0=SINE,1=TRI,2=SQR */
-static volatile uint8  amp_percent  = 100u;
-static volatile uint8  wave_enabled = 0u;
+static volatile uint8  trigSource = TRIG_FREE;
+static volatile uint8  trigState  = TRIG_IDLE;
+static volatile uint32 trigSeen   = 0u;
+static volatile uint16 trigWait   = 0u;
 
-/* ---------- measurement requests ---------- */
-static volatile uint8 meas_r_request = 0u;
-static volatile uint8 meas_c_request = 0u;
+/* ---------- coherent averaging ----------
+ * raw 12-bit samples of avgN synchronised frames are summed here;
+ * scope_task divides down into sampleBuffer once all N are in.
+ */
+static volatile uint32 * const avgAcc = scopeMem;
+static volatile uint16 avgN      = 1u;
+static volatile uint16 avgFrames = 0u;
+
+/* woken by the ISR once a frame (or the last averaged one) is in */
+static TaskHandle_t scopeTask;
+
+/* acquisition settings from the command task, applied by scope_task
+ * between records so a record is never reused while it goes out */
+static volatile uint8  acqPending;
+static volatile uint8  acqRun = 1u;
+static volatile uint8  acqSrc = TRIG_FREE;
+static volatile uint16 acqAvg = 1u;
+static volatile uint16 acqLen = REC_DEFAULT_LEN;
+
+/* STATS: records completed by the ISR, sent whole, abandoned */
+static volatile uint32 framesCaptured;
+static uint32 framesSent;
+static uint32 framesDropped;
 
 /* =========================================================
- *  fast sin approximation
+ *  ADC_SAR_1 ISR: oscilloscope sampling
  * =======================================================*/
-static float my_sin_approx(float x)
+static void scope_sample(void)
 {
-    while (x > 3.1415926f) x -= 6.2831852f;
-    while (x < -3.1415926f) x += 6.2831852f;
-    float x2 = x * x;
-    float x3 = x * x2;
-    float x5 = x3 * x2;
-    return x - x3 / 6.0f + x5 / 120.0f;
-}
+    static uint8 dc = 0u;
+    uint16 raw = ADC_SAR_1_GetResult16();
 
-/* =========================================================
- *  build waveform LUTs
- * =======================================================*/
-static void build_sine(void)
-{
-    uint16 i;
-    for (i = 0u; i < LUT_SIZE; i++)
+    if (frameReady)
+        return;
+
+    if (trigState == TRIG_ARM)
     {
-        float t = 6.2831852f * (float)i / (float)LUT_SIZE;
-        float s = my_sin_approx(t);
-        int16 v = (int16)(128.0f + 127.0f * s);
-        if (v < 0)   v = 0;
-        if (v > 255) v = 255;
-        sineBase[i] = (uint8)v;
+        trigSeen  = wavegen_sync_count();
+        trigWait  = 0u;
+        trigState = TRIG_WAIT;
+        return;
+    }
+    if (trigState == TRIG_WAIT)
+    {
+        /* first sample after the wrap is sample 0 of the frame,
+         * so frames line up to within one ADC conversion */
+        if ((wavegen_sync_count() == trigSeen) &&
+            (++trigWait < TRIG_TIMEOUT_SAMPLES))
+            return;
+        trigState = TRIG_IDLE;
+        dc = DECIM_FACTOR - 1u;
     }
-}
 
-static void build_tri(void)
-{
-    uint16 h = LUT_SIZE / 2u;
-    uint16 i;
+    dc++;
+    if (dc < DECIM_FACTOR)
+        return;
+    dc = 0u;
+
+    if (avgN > 1u)
+    {
+        if (avgFrames == 0u)
+            avgAcc[sampleIndex] = raw;
+        else
+            avgAcc[sampleIndex] += raw;
+    }
+    else
+    {
+        sampleBuffer[sampleIndex] = (uint8)(raw >> ADC_TO_8BIT_SHIFT);
+    }
 
-    for (i = 0u; i < h; i++)
-        triBase[i] = (uint8)((255u * i) / (h - 1u));
+    if (++sampleIndex >= recLen)
+    {
+        sampleIndex = 0u;
+        if (++avgFrames >= avgN)
+        {
+            BaseType_t woken = pdFALSE;
 
-    for (i = 0u; i < h; i++)
-        triBase[h + i] = (uint8)(255u - (255u * i) / (h - 1u));
+            avgFrames  = 0u;
+            frameReady = 1u;
+            framesCaptured++;
+            if (scopeTask)
+            {
+                vTaskNotifyGiveFromISR(scopeTask, &woken);
+                portYIELD_FROM_ISR(woken);
+            }
+        }
+        if (trigSource == TRIG_GEN)
+            trigState = TRIG_ARM;
+    }
 }
 
-static void build_sqr(void)
+CY_ISR(ADC_ISR_Handler)
 {
-    uint16 h = LUT_SIZE / 2u;
-    uint16 i;
+    uint32 t0 = stats_isr_begin();
 
-    for (i = 0u; i < h; i++)
-        sqrBase[i] = 0u;
-    for (i = h; i < LUT_SIZE; i++)
-        sqrBase[i] = 255u;
+    scope_sample();
+    stats_isr_end(STATS_ISR_SCOPE, t0);
 }
 
-static void rebuild_lut(void)
+/* ADC_SAR_1 and isr_adc only run while acquisition is on (RUN:1), so
+ * a paused scope does not wake the CPU out of tickless sleep; main
+ * starts them */
+static void scope_run(uint8 on)
 {
-    uint16 i;
-    const uint8 *src = (waveMode == 1u) ? triBase :
-                       (waveMode == 2u) ? sqrBase : sineBase;
+    static uint8 running = 1u;
 
-    if (amp_percent > 100u) amp_percent = 100u;
-
-    for (i = 0u; i < LUT_SIZE; i++)
+    if (on == running)
+        return;
+    running = on;
+    if (on)
     {
-        uint16 s = ((uint16)src[i] * amp_percent) / 100u;
-        if (s > 255u) s = 255u;
-        waveLUT[i] = (uint8)s;
+        ADC_SAR_1_Start();
+        ADC_SAR_1_StartConvert();
+        isr_adc_ClearPending();
+        isr_adc_Enable();
+    }
+    else
+    {
+        isr_adc_Disable();
+        ADC_SAR_1_Stop();
     }
 }
 
-static void set_amplitude(uint8 a)
-{
-    amp_percent = a;
-    if (amp_percent > 100u) amp_percent = 100u;
-    rebuild_lut();
-}
-
-static void set_wave(uint8 m)
+/* run / trigger source / average count / record length, returns the
+ * length in effect (averaging has room for REC_MAX_AVG_LEN only) */
+static uint16 set_acquisition(uint8 run, uint8 src, uint16 n, uint16 len)
 {
-    waveMode = m;
-    rebuild_lut();
+    if (n < 1u)      n = 1u;
+    if (n > AVG_MAX) n = AVG_MAX;
+    if (len < REC_MIN_LEN) len = REC_MIN_LEN;
+    if (len > REC_MAX_LEN) len = REC_MAX_LEN;
+    if ((n > 1u) && (len > REC_MAX_AVG_LEN))
+        len = REC_MAX_AVG_LEN;
+
+    acqRun     = run;
+    acqSrc     = src;
+    acqAvg     = n;
+    acqLen     = len;
+    acqPending = 1u;
+    xTaskNotifyGive(scopeTask);
+    return len;
 }
 
-static void set_frequency(uint32 f)
+/* scope_task: restart acquisition with the pending settings */
+static void apply_acquisition(void)
 {
-    if (f < 1u)    f = 1u;
-    if (f > 3000u) f = 3000u;
-
-    uint32 rate = f * LUT_SIZE;
-    if (rate == 0u) rate = 1u;
-
-    uint32 p = WAVE_CLK_HZ / rate;
-    if (p == 0u) p = 1u;
-    if (p > 65535u) p = 65535u;
-    p--;
-
-    WaveTimer_Stop();
-    WaveTimer_WriteCounter(0u);
-    WaveTimer_WritePeriod((uint16)p);
-    WaveTimer_Start();
+    /* masks isr_adc; the generator above the ceiling keeps running */
+    taskENTER_CRITICAL();
+
+    acqPending  = 0u;
+    trigSource  = acqSrc;
+    trigState   = (acqSrc == TRIG_GEN) ? TRIG_ARM : TRIG_IDLE;
+    avgN        = acqAvg;
+    recLen      = acqLen;
+    avgFrames   = 0u;
+    sampleIndex = 0u;
+    frameReady  = 0u;
+    taskEXIT_CRITICAL();
+
+    scope_run(acqRun);
 }
 
-/* =========================================================
- *  ADC_SAR_1 ISR: oscilloscope sampling
- * =======================================================*/
-CY_ISR(ADC_ISR_Handler)
+/* averaged record -> 8-bit sampleBuffer, rounded */
+static void finish_average(void)
 {
-    static uint8 dc = 0u;
-    uint16 raw = ADC_SAR_1_GetResult16();
-
-    dc++;
-    if (dc < DECIM_FACTOR)
-        return;
-    dc = 0u;
+    uint16 i;
+    uint32 div  = (uint32)avgN << ADC_TO_8BIT_SHIFT;
 
-    if (!frameReady)
+    for (i = 0u; i < recLen; i++)
     {
-        sampleBuffer[sampleIndex++] = (uint8)(raw >> ADC_TO_8BIT_SHIFT);
-        if (sampleIndex >= FRAME_SAMPLES)
-        {
-            frameReady  = 1u;
-            sampleIndex = 0u;
-        }
+        uint32 v = (avgAcc[i] + (div / 2u)) / div;
+        sampleBuffer[i] = (uint8)((v > 255u) ? 255u : v);
     }
 }
 
 /* =========================================================
- *  WaveTimer ISR: function generator stepping
+ *  UART command parser
  * =======================================================*/
-CY_ISR(WaveTimer_ISR)
-{
-    (void)WaveTimer_ReadStatusRegister();
-
-    if (!wave_enabled)
-    {
-        VDAC8_1_SetValue(0u);
-        return;
-    }
-
-    VDAC8_1_SetValue(waveLUT[waveIndex++]);
-    if (waveIndex >= LUT_SIZE)
-        waveIndex = 0u;
-}
+#define CMD_BUF_LEN 64
+static char   cmdBuf[CMD_BUF_LEN];
+static uint16 cmdLen = 0u;
 
-/* =========================================================
- *  R / C measurement helpers (ADC_SAR_2 + AMux_1 + IDAC_1)
- * =======================================================*/
+static StreamBufferHandle_t rxStream;
+static TaskHandle_t         cmdTask;
+static StaticStreamBuffer_t rxStreamCtl;
+static uint8                rxStreamMem[RX_STREAM_LEN + 1u];
+static volatile uint16      rxDropped;    /* bytes lost to a full rxStream */
+static volatile uint32      rxDropTotal;  /* same, since boot */
+static volatile uint32      rxHwOverrun;  /* UART FIFO overruns */
+
+/* BENCH / STATS / JITTER command seen, run after the line */
+static uint8  benchReq = 0u;
+static uint8  statsReq = 0u;
+static uint32 jitterReq = 0u;
+
+/* ---------- calibration ----------
+ * CAL:R:<ohms> / CAL:C:<pF> measure a reference part (raw, CAL_SHOTS
+ * readings) and fold it into the table; CAL:SCOPE:<ppm>, CAL:SAVE,
+ * CAL:RESET, CAL:SHOW.
+ */
+static int32 calRef;
 
-/* free-running ADC helper for C measurement */
-static uint32 wait_until_mv(int target_mv, uint32 timeout_ms)
+/* CAL_R<range>:gain=..,off=.. (range R_RANGE_COUNT: CAL_C) */
+static void send_cal_entry(uint8 range, const cal_lin_t *c)
 {
-    uint32 elapsed_us = 0u;
-    uint32 timeout_us = timeout_ms * 1000u;
+    char  msg[48];
+    char *p;
 
-    while (elapsed_us < timeout_us)
+    if (range < R_RANGE_COUNT)
     {
-        int32 mv = ADC_SAR_2_CountsTo_mVolts(ADC_SAR_2_GetResult16());
-        if (mv >= target_mv)
-            return elapsed_us;
-
-        CyDelayUs(SAMPLE_US);
-        elapsed_us += SAMPLE_US;
+        p = fmt_str(msg, "CAL_R");
+        p = fmt_u32(p, range);
     }
-    return (uint32)-1;
+    else
+        p = fmt_str(msg, "CAL_C");
+    p = fmt_str(p, ":gain=");
+    p = fmt_i32(p, c->gain_q16);
+    p = fmt_str(p, ",off=");
+    p = fmt_i32(p, c->offset);
+    fmt_eol(p);
+    tx_puts(msg);
 }
 
-/* Resistance on Pin_R to GND */
-static int32 Measure_R_Pin(void)
+static void send_cal_table(void)
 {
-    int32 adc_mV;
-    float v_pin, r_raw, r_cal;
-
-    /* select Pin_R channel on mux */
-    AMux_1_FastSelect(0u);
-
-    Pin_R_SetDriveMode(Pin_R_DM_ALG_HIZ);
-    IDAC_1_SetPolarity(IDAC_1_SOURCE);
-    IDAC_1_SetValue(IDAC_R_CODE);
-
-    CyDelay(20u);
-
-    /* one fresh sample from free-running ADC_SAR_2 */
-    ADC_SAR_2_IsEndConversion(ADC_SAR_2_WAIT_FOR_RESULT);
-    adc_mV = ADC_SAR_2_CountsTo_mVolts(ADC_SAR_2_GetResult16());
-
-    v_pin = adc_mV / 1000.0f;
-    r_raw = v_pin / IDAC_R_CURRENT_A;    /* uncalibrated */
-    if (r_raw < 0.0f) r_raw = 0.0f;
-
-    r_cal = r_raw * R_CAL_GAIN;
-
-    {
-        char dbg[80];
-        sprintf(dbg, "DBG_R: mv=%ld, Rraw=%ld, Rcal=%ld\r\n",
-                (long)adc_mV, (long)r_raw, (long)r_cal);
-        UART_PutString(dbg);
-    }
-
-    return (int32)r_cal;
+    const cal_table_t *c = calib_table();
+    char  msg[24];
+    uint8 i;
+
+    for (i = 0u; i < R_RANGE_COUNT; i++)
+        send_cal_entry(i, &c->r[i]);
+    send_cal_entry(R_RANGE_COUNT, &c->c);
+    fmt_eol(fmt_i32(fmt_str(msg, "CAL_SCOPE:"), c->scope_gain_ppm));
+    tx_puts(msg);
+    tx_puts(calib_from_eeprom() ? "CAL:EEPROM\r\n" : "CAL:DEFAULT\r\n");
 }
 
-/* Capacitance on Pin_C to GND (uF), in small 2..10 mV region */
-static float Measure_C_Pin_uF(void)
+static void process_cal(char *a)
 {
-    /* select Pin_C channel */
-    AMux_1_FastSelect(1u);
-
-    /* fully discharge capacitor */
-    IDAC_1_SetValue(0u);
-    Pin_C_SetDriveMode(Pin_C_DM_STRONG);
-    Pin_C_Write(0u);
-    CyDelay(DISCHARGE_MS);
-
-    /* high-Z and small delay */
-    Pin_C_SetDriveMode(Pin_C_DM_ALG_HIZ);
-    CyDelayUs(50u);
+    uint8 ok = 1u;
 
-    /* start charging with IDAC */
-    IDAC_1_SetPolarity(IDAC_1_SOURCE);
-    IDAC_1_SetValue(IDAC_C_CODE);
-
-    /* ADC_SAR_2 is already in free-running mode */
-    uint32 t1 = wait_until_mv(VSTART_MV, TIMEOUT_MS);
-    uint32 t2 = wait_until_mv(VEND_MV, TIMEOUT_MS);
-
-    IDAC_1_SetValue(0u);  /* stop charging */
-
-    if (t1 == (uint32)-1 || t2 == (uint32)-1 || t2 <= t1)
+    if (!strncmp(a, "R:", 2) || !strncmp(a, "C:", 2))
     {
-        UART_PutString("DBG_C: timeout or bad dt\r\n");
-        return -1.0f;
+        uint8 kind = (a[0] == 'R') ? MEAS_R : MEAS_C;
+        calRef = strtol(a + 2, NULL, 10);
+        ok = (calRef > 0) && meter_request(kind, CAL_SHOTS, MEAS_F_RAW);
     }
+    else if (!strncmp(a, "SCOPE:", 6))
+    {
+        long ppm = strtol(a + 6, NULL, 10);
+        ok = (ppm > 0);
+        if (ok)
+            calib_set_scope_ppm((int32)ppm);
+    }
+    else if (!strcmp(a, "SAVE"))
+        ok = calib_save();
+    else if (!strcmp(a, "RESET"))
+        calib_reset();
+    else if (strcmp(a, "SHOW"))
+        ok = 0u;
+
+    if (!ok)
+        tx_puts("CAL:ERR\r\n");
+    else if (!strcmp(a, "SAVE") || !strcmp(a, "RESET") || !strcmp(a, "SHOW") ||
+             !strncmp(a, "SCOPE:", 6))
+        send_cal_table();
+}
 
-    uint32 dt_us = t2 - t1;
-
-    float dV  = (float)(VEND_MV - VSTART_MV) / 1000.0f; /* volts */
-    float t_s = dt_us * 1e-6f;
-    float C   = (IDAC_C_CURRENT_A * t_s) / dV;          /* Farads */
-    C        *= C_CAL_GAIN;                             /* calibration fudge */
-    float C_uF = C * 1e6f;
+/* raw batch for a CAL reference point is back */
+static void finish_cal(const meas_result_t *res)
+{
+    const cal_lin_t *c;
 
+    if (!res->ok || res->n == 0u)
     {
-        char dbg[80];
-        sprintf(dbg, "DBG_C: dt=%lu us, C=%.3f uF\r\n",
-                (unsigned long)dt_us, (double)C_uF);
-        UART_PutString(dbg);
+        tx_puts("CAL:ERR\r\n");
+        return;
     }
-
-    return C_uF;
+    c = calib_add_point(res->kind, res->range, res->mean, calRef);
+    send_cal_entry((res->kind == MEAS_R) ? res->range : R_RANGE_COUNT, c);
 }
 
-/* =========================================================
- *  UART command parser
- * =======================================================*/
-#define CMD_BUF_LEN 64
-static char   cmdBuf[CMD_BUF_LEN];
-static uint16 cmdLen = 0u;
-
 static void process_cmd(char *cmd)
 {
+    uint8  gen_changed = 0u;
+    uint8  acq_changed = 0u;
+    uint8  acq_run = acqRun;
+    uint8  acq_src = acqSrc;
+    uint16 acq_avg = acqAvg, acq_len = acqLen;
     char *t = strtok(cmd, ",");
     while (t)
     {
@@ -336,45 +413,239 @@ static void process_cmd(char *cmd)
             if (a < 0)   a = 0;
             if (a > 100) a = 100;
             set_amplitude((uint8)a);
+            gen_changed = 1u;
+        }
+        else if (!strncmp(t, "AMPMV:", 6))
+        {
+            int a = atoi(t + 6);
+            if (a < 0) a = 0;
+            set_amplitude_mv((uint16)a);
+            gen_changed = 1u;
+        }
+        else if (!strncmp(t, "OFFS:", 5))
+        {
+            set_offset_mv((int16)atoi(t + 5));
+            gen_changed = 1u;
+        }
+        else if (!strncmp(t, "DITH:", 5))
+        {
+            set_dither(atoi(t + 5) ? 1u : 0u);
         }
         else if (!strncmp(t, "WAVE:", 5))
         {
             char *w = t + 5;
-            if      (!strcmp(w, "SINE")) set_wave(0u);
-            else if (!strcmp(w, "TRI"))  set_wave(1u);
-            else if (!strcmp(w, "SQR"))  set_wave(2u);
+            if      (!strcmp(w, "SINE")) set_wave(WAVE_SINE);
+            else if (!strcmp(w, "TRI"))  set_wave(WAVE_TRI);
+            else if (!strcmp(w, "SQR"))  set_wave(WAVE_SQR);
+            else if (!strcmp(w, "NOISE"))  set_wave(WAVE_NOISE);
+            else if (!strcmp(w, "GNOISE")) set_wave(WAVE_GNOISE);
+            else if (!strcmp(w, "MULTI"))  set_wave(WAVE_MULTI);
+            gen_changed = 1u;
         }
-        else if (!strncmp(t, "EN:", 3))
+        else if (!strncmp(t, "TONE:", 5))
         {
-            int e = atoi(t + 3);
-            if (e)
-                wave_enabled = 1u;
+            /* TONE:<slot>:<harm>:<amp%>:<phase deg> or TONE:CLR */
+            if (!strcmp(t + 5, "CLR"))
+                clear_tones();
             else
             {
-                wave_enabled = 0u;
-                VDAC8_1_SetValue(0u);
-                waveIndex = 0u;
+                char *p = t + 5;
+                long v[4] = { 0, 0, 0, 0 };
+                uint8 n;
+
+                for (n = 0u; n < 4u; n++)
+                {
+                    v[n] = strtol(p, &p, 10);
+                    if (*p != ':')
+                        break;
+                    p++;
+                }
+                if (n == 3u && v[0] >= 0 && v[1] >= 0 && v[2] >= 0 && v[3] >= 0)
+                    set_tone((uint8)v[0], (uint16)v[1],
+                             (uint8)((v[2] > 100) ? 100 : v[2]), (uint16)v[3]);
             }
+            gen_changed = 1u;
+        }
+        else if (!strncmp(t, "EN:", 3))
+        {
+            set_wave_enabled(atoi(t + 3) ? 1u : 0u);
+        }
+        else if (!strncmp(t, "RUN:", 4))
+        {
+            acq_run = atoi(t + 4) ? 1u : 0u;
+            acq_changed = 1u;
+        }
+        else if (!strncmp(t, "TRIG:", 5))
+        {
+            char *m = t + 5;
+            if      (!strcmp(m, "GEN"))  acq_src = TRIG_GEN;
+            else if (!strcmp(m, "FREE")) acq_src = TRIG_FREE;
+            acq_changed = 1u;
+        }
+        else if (!strncmp(t, "AVG:", 4))
+        {
+            int n = atoi(t + 4);
+            if (n < 1)             n = 1;
+            if (n > (int)AVG_MAX)  n = (int)AVG_MAX;
+            acq_avg = (uint16)n;
+            acq_changed = 1u;
+        }
+        else if (!strncmp(t, "LEN:", 4))
+        {
+            /* record length in samples, REC_MIN_LEN..REC_MAX_LEN */
+            long n = strtol(t + 4, NULL, 10);
+            if (n < (long)REC_MIN_LEN)  n = (long)REC_MIN_LEN;
+            if (n > (long)REC_MAX_LEN)  n = (long)REC_MAX_LEN;
+            acq_len = (uint16)n;
+            acq_changed = 1u;
         }
         else if (!strncmp(t, "MEAS:", 5))
         {
+            /* MEAS:R / C / D[:<uA>] / CONT / L / CFIT / ALL, optionally
+             * followed by an N=<count> token (ALL: N scans).
+             * Returns at once; the meter task posts the result to its
+             * queue and cmd_task drains it. */
             char *m = t + 5;
+            long n = 1;
+            uint8 ok = 1u;
+
+            t = strtok(NULL, ",");
+            if (t && !strncmp(t, "N=", 2))
+            {
+                n = strtol(t + 2, NULL, 10);
+                if (n < 1)                    n = 1;
+                if (n > (long)MEAS_BATCH_MAX) n = (long)MEAS_BATCH_MAX;
+                t = strtok(NULL, ",");
+            }
+
             if (!strcmp(m, "R"))
-                meas_r_request = 1u;
+                ok = meter_request(MEAS_R, (uint16)n, 0u);
             else if (!strcmp(m, "C"))
-                meas_c_request = 1u;
+                ok = meter_request(MEAS_C, (uint16)n, 0u);
+            else if (!strncmp(m, "D", 1) && (m[1] == '\0' || m[1] == ':'))
+            {
+                /* MEAS:D or MEAS:D:<uA> */
+                meter_set_diode_current((m[1] == ':') ? (uint16)atoi(m + 2) : 0u);
+                ok = meter_request(MEAS_D, (uint16)n, 0u);
+            }
+            else if (!strcmp(m, "CONT"))
+                ok = meter_request(MEAS_CONT, (uint16)n, 0u);
+            else if (!strcmp(m, "L"))
+                ok = meter_request(MEAS_L, (uint16)n, 0u);
+            else if (!strcmp(m, "CFIT"))
+                ok = meter_request(MEAS_CFIT, (uint16)n, 0u);
+            else if (!strcmp(m, "ALL"))
+                ok = meter_request(MEAS_ALL, (uint16)n, 0u);
+            if (!ok)
+                tx_puts("MEAS:BUSY\r\n");
+            continue;   /* already holds the next token */
+        }
+        else if (!strncmp(t, "METER:", 6))
+        {
+            /* METER:R:<ms> / METER:C:<ms> / METER:OFF */
+            char *m = t + 6;
+            long  ms = 0;
+            uint8 kind = 0xFFu;
+
+            if ((m[0] == 'R' || m[0] == 'C') && m[1] == ':')
+            {
+                kind = (m[0] == 'R') ? MEAS_R : MEAS_C;
+                ms   = strtol(m + 2, NULL, 10);
+                if (ms < 0)      ms = 0;
+                if (ms > 65535)  ms = 65535;
+            }
+            if (!meter_stream(kind, (uint16)ms))
+                tx_puts("MEAS:BUSY\r\n");
+        }
+        else if (!strncmp(t, "CAL:", 4))
+        {
+            process_cal(t + 4);
+        }
+        else if (!strcmp(t, "BENCH"))
+        {
+            benchReq = 1u;   /* run by cmd_task, after this line */
+        }
+        else if (!strcmp(t, "STATS"))
+        {
+            statsReq = 1u;
+        }
+        else if (!strcmp(t, "STATS:RESET"))
+        {
+            statsReq = 2u;
+        }
+        else if (!strncmp(t, "JITTER", 6))
+        {
+            /* JITTER or JITTER:<intervals> */
+            long n = (t[6] == ':') ? strtol(t + 7, NULL, 10) : (long)JITTER_DEFAULT_N;
+
+            if (n < 1)                 n = 1;
+            if (n > (long)JITTER_MAX_N) n = (long)JITTER_MAX_N;
+            jitterReq = (uint32)n;
         }
 
         t = strtok(NULL, ",");
     }
+
+    /* RUN / TRIG / AVG / LEN: one restart per line, and the record
+     * length that applies (averaging caps it) */
+    if (acq_changed)
+    {
+        char msg[24];
+        acq_len = set_acquisition(acq_run, acq_src, acq_avg, acq_len);
+        fmt_eol(fmt_u32(fmt_str(msg, "REC_LEN:"), acq_len));
+        tx_puts(msg);
+    }
+
+    /* offset + amplitude ran past 0 V / full scale */
+    if (gen_changed && wavegen_clip_count())
+    {
+        char msg[24];
+        fmt_eol(fmt_u32(fmt_str(msg, "GEN_CLIP:"), wavegen_clip_count()));
+        tx_puts(msg);
+    }
 }
 
-static void poll_uart_commands(void)
+/* UART_RXISR hook (cyapicallbacks.h): the component ISR has just
+ * moved the hardware FIFO into its 16-byte buffer; pass it all on to
+ * rxStream and wake the command task once a line is complete. */
+void UART_RXISR_ExitCallback(void)
 {
-    while (UART_GetRxBufferSize() > 0u)
+    BaseType_t woken = pdFALSE;
+    uint8      buf[UART_RX_BUFFER_SIZE];
+    uint8      n = 0u, eol = 0u;
+    uint32     t0 = stats_isr_begin();
+
+    if (rxStream == NULL)
+        return;     /* before main() made it; the bytes wait in the UART */
+
+    if (UART_errorStatus & UART_RX_STS_OVERRUN)
+    {
+        UART_errorStatus &= (uint8)~UART_RX_STS_OVERRUN;
+        rxHwOverrun++;
+    }
+
+    while ((UART_GetRxBufferSize() > 0u) && (n < sizeof(buf)))
     {
-        char c = (char)UART_GetChar();
+        buf[n] = UART_ReadRxData();
+        if (buf[n] == '\r' || buf[n] == '\n')
+            eol = 1u;
+        n++;
+    }
+    n -= (uint8)xStreamBufferSendFromISR(rxStream, buf, n, &woken);
+    rxDropped   += n;
+    rxDropTotal += n;
+    if (eol && cmdTask)
+        vTaskNotifyGiveFromISR(cmdTask, &woken);
+    stats_isr_end(STATS_ISR_UART, t0);
+    portYIELD_FROM_ISR(woken);
+}
+
+static void read_uart_commands(void)
+{
+    char c;
 
+    while (xStreamBufferReceive(rxStream, &c, 1u, 0u) == 1u)
+    {
         if (c == '\r' || c == '\n')
         {
             if (cmdLen > 0u)
@@ -390,48 +661,556 @@ static void poll_uart_commands(void)
                 cmdBuf[cmdLen++] = c;
         }
     }
+
+    if (rxDropped)
+    {
+        rxDropped = 0u;
+        tx_puts("RX:OVERRUN\r\n");
+    }
 }
 
 /* =========================================================
- *  main FreeRTOS app task
+ *  command task: UART commands in, replies and results out
  * =======================================================*/
-static void app_task(void *arg)
+/* result lines go out through here so BENCH can time the formatting
+ * alone */
+static uint8 txMute;
+
+static void put_line(uint8 ch, const char *msg)
+{
+    if (!txMute)
+        (void)tx_line(ch, msg);
+}
+
+/* the raw numbers behind a single result, as a log record; the host
+ * prints them as the old DBG_ lines */
+static void log_meas(const meas_result_t *res)
+{
+    switch (res->kind)
+    {
+    case MEAS_R:
+        LOG(LOG_DBG_R, res->mv, res->range, res->code, res->r_raw, res->r_ohm);
+        break;
+    case MEAS_C:
+        LOG(LOG_DBG_C, res->ok, (int32)res->dt_ns, res->c_pf);
+        break;
+    case MEAS_D:
+        LOG(LOG_DBG_D, res->mv, res->r_raw, res->code);
+        break;
+    case MEAS_L:
+        LOG(LOG_DBG_L, (int32)res->dt_ns, res->r_raw, res->mv);
+        break;
+    case MEAS_CFIT:
+        LOG(LOG_DBG_CFIT, (int32)res->dt_ns, res->c_pf, res->leak_kohm,
+            (int32)res->fit_pm);
+        break;
+    default:
+        break;
+    }
+}
+
+static void send_meas_result(const meas_result_t *res)
+{
+    char  msg[96];
+    char *p;
+
+    static const char * const kindName[] = { "R", "C", "D", "CONT", "L", "CFIT", "ALL" };
+    static const char * const dName[]    = { "FWD", "OPEN", "SHORT", "RES" };
+    static const char * const lName[]    = { "OK", "SMALL", "LARGE", "NOPATH", "NOFIXTURE" };
+
+    if (res->kind == MEAS_ALL)
+    {
+        /* ohms (-1 open), R range, pF (-1 timeout), channel bits, us */
+        p = fmt_str(msg, "ALL:");
+        p = fmt_i32(p, res->r_ohm);
+        *p++ = ',';
+        p = fmt_u32(p, res->range);
+        *p++ = ',';
+        p = fmt_i32(p, res->c_pf);
+        *p++ = ',';
+        p = fmt_u32(p, res->ch_ok);
+        *p++ = ',';
+        fmt_eol(fmt_u32(p, res->scan_us));
+        put_line(TX_CH_MEAS, msg);
+        return;
+    }
+
+    if (res->n > 1u || res->fails)
+    {
+        /* batch: one line; ohms for R, pF for C, mV for D/CONT, nH for L */
+        p = fmt_str(msg, kindName[res->kind]);
+        p = fmt_str(p, "_STAT:n=");
+        p = fmt_u32(p, res->n);
+        p = fmt_str(p, ",mean=");
+        p = fmt_i32(p, res->mean);
+        p = fmt_str(p, ",sd=");
+        p = fmt_i32(p, res->sd);
+        p = fmt_str(p, ",min=");
+        p = fmt_i32(p, res->min);
+        p = fmt_str(p, ",max=");
+        p = fmt_i32(p, res->max);
+        p = fmt_str(p, ",fail=");
+        p = fmt_u32(p, res->fails);
+        fmt_eol(p);
+        put_line(TX_CH_MEAS, msg);
+        return;
+    }
+
+    if (!txMute)
+        log_meas(res);
+
+    if (res->kind == MEAS_D)
+    {
+        p = fmt_str(msg, "DIODE:");
+        p = fmt_str(p, dName[res->cls & 3u]);
+        *p++ = ',';
+        fmt_eol(fmt_i32(p, res->mv));
+        put_line(TX_CH_MEAS, msg);
+    }
+    else if (res->kind == MEAS_CONT)
+    {
+        p = fmt_str(msg, "CONT:");
+        p = fmt_u32(p, res->cls);
+        *p++ = ',';
+        p = fmt_i32(p, res->r_raw);
+        *p++ = ',';
+        fmt_eol(fmt_u32(p, res->dt_ns / 1000u));
+        put_line(TX_CH_MEAS, msg);
+    }
+    else if (res->kind == MEAS_L)
+    {
+        p = fmt_str(msg, "L_uH:");
+        if (res->ok)
+            p = fmt_i32(p, res->l_nh / 1000);
+        else
+            p = fmt_str(p, lName[(res->cls <= L_NO_FIXTURE) ? res->cls : L_NO_PATH]);
+        fmt_eol(p);
+        put_line(TX_CH_MEAS, msg);
+    }
+    else if (res->kind == MEAS_R)
+    {
+        fmt_eol(fmt_u32(fmt_str(msg, "R_RNG:"), res->range));
+        put_line(TX_CH_MEAS, msg);
+        fmt_eol(fmt_i32(fmt_str(msg, "R_GND:"), res->r_ohm));
+        put_line(TX_CH_MEAS, msg);
+    }
+    else if (res->kind == MEAS_CFIT)
+    {
+        /* pF, kohm (-1: none seen), residual per mille; pF -1 on failure */
+        p = fmt_str(msg, "CFIT:");
+        p = fmt_i32(p, res->ok ? res->c_pf : -1);
+        *p++ = ',';
+        p = fmt_i32(p, res->leak_kohm);
+        *p++ = ',';
+        fmt_eol(fmt_u32(p, res->fit_pm));
+        put_line(TX_CH_MEAS, msg);
+    }
+    else
+    {
+        /* uF with 3 decimals = nF, rounded; -1.000 on timeout */
+        int32 c_nf = res->ok ? (res->c_pf + 500) / 1000 : -1000;
+
+        fmt_eol(fmt_fix(fmt_str(msg, "C_uF:"), c_nf, 3u));
+        put_line(TX_CH_MEAS, msg);
+    }
+}
+
+#if BENCH_SPRINTF
+/* the same lines through newlib's sprintf, C as a float in uF: the
+ * reference BENCH times fmt.c against */
+static void send_meas_result_sprintf(const meas_result_t *res)
+{
+    char msg[96];
+
+    static const char * const kindName[] = { "R", "C", "D", "CONT", "L", "CFIT", "ALL" };
+    static const char * const dName[]    = { "FWD", "OPEN", "SHORT", "RES" };
+    static const char * const lName[]    = { "OK", "SMALL", "LARGE", "NOPATH", "NOFIXTURE" };
+
+    if (res->n > 1u || res->fails)
+    {
+        sprintf(msg, "%s_STAT:n=%u,mean=%ld,sd=%ld,min=%ld,max=%ld,fail=%u\r\n",
+                kindName[res->kind], (unsigned)res->n,
+                (long)res->mean, (long)res->sd, (long)res->min,
+                (long)res->max, (unsigned)res->fails);
+        put_line(TX_CH_MEAS, msg);
+    }
+    else if (res->kind == MEAS_D)
+    {
+        sprintf(msg, "DIODE:%s,%ld\r\n", dName[res->cls & 3u], (long)res->mv);
+        put_line(TX_CH_MEAS, msg);
+    }
+    else if (res->kind == MEAS_L)
+    {
+        if (res->ok)
+            sprintf(msg, "L_uH:%ld\r\n", (long)(res->l_nh / 1000));
+        else
+            sprintf(msg, "L_uH:%s\r\n",
+                    lName[(res->cls <= L_NO_FIXTURE) ? res->cls : L_NO_PATH]);
+        put_line(TX_CH_MEAS, msg);
+    }
+    else if (res->kind == MEAS_R)
+    {
+        sprintf(msg, "R_RNG:%u\r\n", (unsigned)res->range);
+        put_line(TX_CH_MEAS, msg);
+        sprintf(msg, "R_GND:%ld\r\n", (long)res->r_ohm);
+        put_line(TX_CH_MEAS, msg);
+    }
+    else if (res->kind == MEAS_C)
+    {
+        float c_uF = res->ok ? (float)res->c_pf / 1.0e6f : -1.0f;
+
+        sprintf(msg, "C_uF:%.3f\r\n", (double)c_uF);
+        put_line(TX_CH_MEAS, msg);
+    }
+    else
+    {
+        /* not in the BENCH set */
+        send_meas_result(res);
+    }
+}
+#endif
+
+/* ---------- BENCH ----------
+ * Times the text path on a fixed set of results with the UART muted:
+ * cycles per result, averaged over BENCH_PASSES passes, plus the CMD
+ * task stack headroom. With BENCH_SPRINTF, sprintf_cyc is the same set
+ * through sprintf and stack_free covers both.
+ */
+static void run_bench(void)
+{
+    static const meas_result_t sample[] =
+    {
+        { .kind = MEAS_R, .ok = 1u, .mv = 1234, .range = R_RANGE_255UA,
+          .code = 200u, .r_raw = 6170, .r_ohm = 6150 },
+        { .kind = MEAS_C, .ok = 1u, .dt_ns = 4266666u, .c_pf = 1000000 },
+        { .kind = MEAS_D, .ok = 1u, .mv = 612, .r_raw = 571, .cls = D_FWD },
+        { .kind = MEAS_L, .ok = 1u, .dt_ns = 100000u, .r_raw = 12, .mv = 3000,
+          .l_nh = 10000000 },
+        { .kind = MEAS_C, .n = 32u, .mean = 1000000, .sd = 512,
+          .min = 998000, .max = 1002000 },
+    };
+    char   msg[128];
+    char  *p;
+    uint32 t0, cyc[sizeof(sample) / sizeof(sample[0])];
+    uint8  i, k;
+#if BENCH_SPRINTF
+    uint32 ref[sizeof(sample) / sizeof(sample[0])];
+#endif
+
+    for (i = 0u; i < sizeof(sample) / sizeof(sample[0]); i++)
+    {
+        txMute = 1u;
+        t0 = cycles_now();
+        for (k = 0u; k < BENCH_PASSES; k++)
+            send_meas_result(&sample[i]);
+        cyc[i] = (cycles_now() - t0) / BENCH_PASSES;
+#if BENCH_SPRINTF
+        t0 = cycles_now();
+        for (k = 0u; k < BENCH_PASSES; k++)
+            send_meas_result_sprintf(&sample[i]);
+        ref[i] = (cycles_now() - t0) / BENCH_PASSES;
+#endif
+        txMute = 0u;
+    }
+
+    p = fmt_str(msg, "BENCH:fmt_cyc=");
+    for (i = 0u; i < sizeof(sample) / sizeof(sample[0]); i++)
+    {
+        if (i)
+            *p++ = '/';
+        p = fmt_u32(p, cyc[i]);
+    }
+#if BENCH_SPRINTF
+    p = fmt_str(p, ",sprintf_cyc=");
+    for (i = 0u; i < sizeof(sample) / sizeof(sample[0]); i++)
+    {
+        if (i)
+            *p++ = '/';
+        p = fmt_u32(p, ref[i]);
+    }
+#endif
+    p = fmt_str(p, ",stack_free=");
+    fmt_eol(fmt_u32(p, (uint32)uxTaskGetStackHighWaterMark(NULL)));
+    tx_puts(msg);
+}
+
+/* ---------- STATS ----------
+ * Per ISR: entries and CPU cycles per entry (min/avg/max) plus its share
+ * of wall time, since boot or STATS:RESET. Per task: share of awake CPU
+ * time and free stack words. Then frame, UART RX, per TX class and
+ * sleep counters since boot. Ends with STATS:END.
+ */
+#define STATS_MAX_TASKS    8u
+
+static char *fmt_share(char *p, uint64 part, uint64 whole)
+{
+    /* percent with one decimal */
+    return fmt_fix(p, whole ? (int32)((part * 1000u) / whole) : 0, 1u);
+}
+
+static void send_stats(void)
+{
+    static const char * const isrName[STATS_ISR_COUNT] = { "SCOPE", "WAVE", "METER", "UART" };
+    static const char * const txName[TX_CH_COUNT]      = { "CTRL", "MEAS", "FRAME", "DEBUG" };
+    static TaskStatus_t task[STATS_MAX_TASKS];
+    char        msg[96];
+    char       *p;
+    stats_isr_t st;
+    uint32_t    total;                /* uxTaskGetSystemState's type */
+    uint32      sent, dropped;
+    uint64      wall, up;
+    TickType_t  ticks;
+    UBaseType_t i, n;
+
+    wall = (uint64)(xTaskGetTickCount() - stats_since()) *
+           (1000u * CYCLES_PER_US * 1000u / configTICK_RATE_HZ);
+    for (i = 0u; i < STATS_ISR_COUNT; i++)
+    {
+        stats_isr_get((uint8)i, &st);
+        p = fmt_str(fmt_str(msg, "STATS_ISR:"), isrName[i]);
+        p = fmt_u32(fmt_str(p, ",n="), st.n);
+        p = fmt_u32(fmt_str(p, ",min="), st.n ? st.min : 0u);
+        p = fmt_u32(fmt_str(p, ",avg="), st.n ? (uint32)(st.sum / st.n) : 0u);
+        p = fmt_u32(fmt_str(p, ",max="), st.max);
+        fmt_eol(fmt_share(fmt_str(p, ",load_pct="), st.sum, wall));
+        tx_puts(msg);
+    }
+
+    n = uxTaskGetSystemState(task, STATS_MAX_TASKS, &total);
+    for (i = 0u; i < n; i++)
+    {
+        p = fmt_str(fmt_str(msg, "STATS_TASK:"), task[i].pcTaskName);
+        p = fmt_u32(fmt_str(p, ",prio="), (uint32)task[i].uxCurrentPriority);
+        p = fmt_share(fmt_str(p, ",cpu_pct="), task[i].ulRunTimeCounter, total);
+        fmt_eol(fmt_u32(fmt_str(p, ",stack_free="), (uint32)task[i].usStackHighWaterMark));
+        tx_puts(msg);
+    }
+
+    tx_counts(TX_CH_FRAME, &sent, &dropped);
+    p = fmt_u32(fmt_str(msg, "STATS_FRAMES:captured="), framesCaptured);
+    p = fmt_u32(fmt_str(p, ",sent="), framesSent);
+    p = fmt_u32(fmt_str(p, ",dropped="), framesDropped);
+    fmt_eol(fmt_u32(fmt_str(p, ",chunks="), sent));
+    tx_puts(msg);
+
+    p = fmt_u32(fmt_str(msg, "STATS_UART:rx_overrun="), rxHwOverrun);
+    fmt_eol(fmt_u32(fmt_str(p, ",rx_dropped="), rxDropTotal));
+    tx_puts(msg);
+
+    for (i = 0u; i < TX_CH_COUNT; i++)
+    {
+        tx_counts((uint8)i, &sent, &dropped);
+        p = fmt_str(fmt_str(msg, "STATS_TX:"), txName[i]);
+        p = fmt_u32(fmt_str(p, ",sent="), sent);
+        p = fmt_u32(fmt_str(p, ",dropped="), dropped);
+        fmt_eol(fmt_u32(fmt_str(p, ",bytes="), tx_bytes((uint8)i)));
+        tx_puts(msg);
+    }
+
+    /* residency: SysTick counts spent in WFI over the uptime */
+    ticks = xTaskGetTickCount();
+    up = (uint64)ticks * (1000u * CYCLES_PER_US * 1000u / configTICK_RATE_HZ);
+    p = fmt_u32(fmt_str(msg, "STATS_PWR:up_ticks="), (uint32)ticks);
+    p = fmt_u32(fmt_str(p, ",sleeps="), power_sleep_count());
+    p = fmt_u32(fmt_str(p, ",sleep_ticks="), power_sleep_ticks());
+    fmt_eol(fmt_share(fmt_str(p, ",asleep_pct="), power_sleep_cycles(), up));
+    tx_puts(msg);
+
+    tx_puts("STATS:END\r\n");
+}
+
+/* ---------- JITTER ----------
+ * Arms the WaveTimer_ISR entry meter for n intervals with sleep held
+ * off (DWT stops in Alternate Active) and reports it in cycles:
+ *   JITTER:n=..,period=..,dev_min=..,dev_max=..,tie_pp=..,missed=..
+ *   JITTER_HIST:bin=<cycles>,<count>/<count>/...  (bin 0 starts at
+ *   -WAVE_JIT_BINS/2 bins; the end bins take the overflow)
+ * The ISR rate is 31-62.5 kHz, so JITTER_MAX_N intervals take up to
+ * 2.1 s; a run is cut off after n/16 + 100 ms, 4.2 s at JITTER_MAX_N.
+ * cmd_task goes on parsing commands and draining meter results
+ * meanwhile, and polls the run every JITTER_POLL_MS.
+ */
+static uint8      jitterRunning = 0u;
+static TickType_t jitterLimit;
+
+static void start_jitter(uint32 n)
+{
+    if (jitterRunning)
+    {
+        tx_puts("JITTER:BUSY\r\n");
+        return;
+    }
+    jitterLimit   = xTaskGetTickCount() + pdMS_TO_TICKS(n / 16u + 100u);
+    jitterRunning = 1u;
+    power_hold();
+    wavegen_jitter_start(n);
+}
+
+/* reports the run once it is complete or out of time */
+static void poll_jitter(void)
+{
+    wave_jitter_t j;
+    char          msg[200];
+    char         *p;
+    uint8         i;
+
+    if (!jitterRunning)
+        return;
+    if (wavegen_jitter_busy() && ((int32)(jitterLimit - xTaskGetTickCount()) > 0))
+        return;
+    wavegen_jitter_stop();
+    power_release();
+    jitterRunning = 0u;
+
+    wavegen_jitter_get(&j);
+    if (j.n == 0u)
+    {
+        tx_puts("JITTER:NONE\r\n");
+        return;
+    }
+    p = fmt_u32(fmt_str(msg, "JITTER:n="), j.n);
+    p = fmt_u32(fmt_str(p, ",period="), j.period);
+    p = fmt_i32(fmt_str(p, ",dev_min="), j.dev_min);
+    p = fmt_i32(fmt_str(p, ",dev_max="), j.dev_max);
+    p = fmt_u32(fmt_str(p, ",tie_pp="), (uint32)(j.tie_max - j.tie_min));
+    fmt_eol(fmt_u32(fmt_str(p, ",missed="), j.missed));
+    tx_puts(msg);
+
+    p = fmt_u32(fmt_str(msg, "JITTER_HIST:bin="), WAVE_JIT_BIN_CYC);
+    for (i = 0u; i < WAVE_JIT_BINS; i++)
+    {
+        *p++ = i ? '/' : ',';
+        p = fmt_u32(p, j.hist[i]);
+    }
+    fmt_eol(p);
+    tx_puts(msg);
+}
+
+static void put_le(uint8 *p, uint32 v, uint8 n)
+{
+    while (n--)
+    {
+        *p++ = (uint8)v;
+        v >>= 8;
+    }
+}
+
+static void send_meter_record(const meas_result_t *res)
 {
+    uint8 rec[2u + METER_REC_LEN];
+    int32 v = (res->kind == MEAS_C) ? res->c_pf : res->r_ohm;
+
+    rec[0] = METER_MARK;
+    rec[1] = METER_REC_LEN;
+    rec[2] = res->kind;
+    rec[3] = (uint8)((res->ok ? 1u : 0u) | ((res->range & 0x03u) << 1));
+    put_le(&rec[4],  res->seq, 2u);
+    put_le(&rec[6],  res->t_ms, 4u);
+    put_le(&rec[10], (uint32)v, 4u);
+    (void)tx_send(TX_CH_MEAS, rec, sizeof(rec), 0u);  /* full: seq shows it */
+}
+
+static void cmd_task(void *arg)
+{
+    meas_result_t res;
     (void)arg;
 
     for (;;)
     {
-        poll_uart_commands();
+        /* one notification per complete RX line and per meter result;
+         * a JITTER run is polled as well */
+        (void)ulTaskNotifyTake(pdTRUE, jitterRunning ? pdMS_TO_TICKS(JITTER_POLL_MS)
+                                                     : portMAX_DELAY);
 
-        if (meas_r_request)
+        read_uart_commands();
+        if (benchReq)
+        {
+            benchReq = 0u;
+            run_bench();
+        }
+        if (statsReq == 1u)
         {
-            meas_r_request = 0u;
-            int32 r = Measure_R_Pin();
-            char msg[32];
-            sprintf(msg, "R_GND:%ld\r\n", (long)r);
-            UART_PutString(msg);
+            send_stats();
         }
+        else if (statsReq == 2u)
+        {
+            stats_reset();
+            tx_puts("STATS:RESET\r\n");
+        }
+        statsReq = 0u;
+        if (jitterReq)
+        {
+            start_jitter(jitterReq);
+            jitterReq = 0u;
+        }
+        poll_jitter();
 
-        if (meas_c_request)
+        while (meter_get_result(&res, 0u))
         {
-            meas_c_request = 0u;
-            float c = Measure_C_Pin_uF();
-            char msg[40];
-            sprintf(msg, "C_uF:%.3f\r\n", (double)c);
-            UART_PutString(msg);
+            if (res.flags & MEAS_F_STREAM)
+                send_meter_record(&res);
+            else if (res.flags & MEAS_F_RAW)
+                finish_cal(&res);
+            else
+                send_meas_result(&res);
         }
+    }
+}
+
+/* =========================================================
+ *  scope task: hands finished records to TX
+ * =======================================================*/
+/* The record stays in scopeMem (acquisition held off by frameReady)
+ * while it goes out in chunks; TX puts replies between chunks, so
+ * a deep record does not hold up the command channel. */
+static void send_record(void)
+{
+    static uint8 chunk[FRAME_HDR_LEN + SCOPE_CHUNK];
+    static uint8 recSeq;
+    uint16 len = recLen, off, n;
+
+    chunk[0] = FRAME_MARK;
+    chunk[1] = recSeq++;
+    put_le(&chunk[2], len, 2u);
 
-        if (frameReady)
+    for (off = 0u; off < len; off += n)
+    {
+        n = (uint16)(len - off);
+        if (n > SCOPE_CHUNK)
+            n = SCOPE_CHUNK;
+        if (acqPending)
+            break;      /* settings changed: this record is stale */
+        put_le(&chunk[4], off, 2u);
+        chunk[6] = (uint8)n;
+        memcpy(&chunk[FRAME_HDR_LEN], (const uint8 *)&sampleBuffer[off], n);
+        if (!tx_send(TX_CH_FRAME, chunk, (uint16)(FRAME_HDR_LEN + n), SCOPE_CHUNK_WAIT_MS))
+            break;      /* TX behind: the next record is fresher */
+    }
+    if (off >= len)
+        framesSent++;
+    else
+        framesDropped++;
+}
+
+static void scope_task(void *arg)
+{
+    (void)arg;
+
+    for (;;)
+    {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (acqPending)
         {
-            uint8 header[2];
-            header[0] = 0xAA;
-            header[1] = (uint8)FRAME_SAMPLES;
-            UART_PutArray(header, 2);
-            UART_PutArray((uint8 *)sampleBuffer, FRAME_SAMPLES);
-            frameReady = 0u;
+            apply_acquisition();
+            continue;
         }
+        if (!frameReady)
+            continue;
 
-        vTaskDelay(pdMS_TO_TICKS(1));
+        if (avgN > 1u)
+            finish_average();
+        send_record();
+        frameReady = 0u;
     }
 }
 
@@ -440,11 +1219,17 @@ static void app_task(void *arg)
  * =======================================================*/
 extern void FreeRTOS_Start(void);
 
+/* kernel objects, statically allocated (FreeRTOSConfig.h) */
+static StaticTask_t cmdTcb, scopeTcb;
+static StackType_t  cmdStack[CMD_TASK_STACK];
+static StackType_t  scopeStack[SCOPE_TASK_STACK];
+
 int main(void)
 {
     CyGlobalIntEnable;
 
     UART_Start();
+    log_start();
 
     /* oscilloscope ADC */
     ADC_SAR_1_Start();
@@ -457,23 +1242,27 @@ int main(void)
     IDAC_1_Start();
     AMux_1_Start();
 
-    /* waveform generator */
-    build_sine();
-    build_tri();
-    build_sqr();
-    rebuild_lut();
+    /* waveform generator (integer only, no float work before READY) */
+    wavegen_start();
 
-    VDAC8_1_Start();
-    VDAC8_1_SetValue(0u);
-    WaveClock_Start();
-    WaveTimer_Start();
-    isr_wave_StartEx(WaveTimer_ISR);
-    set_frequency(1000u);
+    /* meter/scope calibration from emulated EEPROM */
+    calib_load();
 
-    FreeRTOS_Start();
-    xTaskCreate(app_task, "APP", 256u, NULL, 3u, NULL);
+    /* generator above the syscall ceiling, acquisition below it */
+    irq_prio_apply();
 
-    UART_PutString("READY\r\n");
+    FreeRTOS_Start();
+    tx_start();
+    rxStream  = xStreamBufferCreateStatic(RX_STREAM_LEN, 1u, rxStreamMem, &rxStreamCtl);
+    cmdTask   = xTaskCreateStatic(cmd_task, "CMD", CMD_TASK_STACK, NULL, CMD_TASK_PRIO,
+                                  cmdStack, &cmdTcb);
+    scopeTask = xTaskCreateStatic(scope_task, "SCOPE", SCOPE_TASK_STACK, NULL,
+                                  SCOPE_TASK_PRIO, scopeStack, &scopeTcb);
+    meter_start();
+    meter_notify(cmdTask);
+
+    tx_puts("READY\r\n");
+    send_cal_table();
 
     vTaskStartScheduler();
 
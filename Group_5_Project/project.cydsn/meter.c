@@ -0,0 +1,1208 @@
+#include <project.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "meter.h"
+#include "cpu_cycles.h"
+#include "calib.h"
+#include "power.h"
+#include "stats.h"
+
+/* ---------- R measurement (auto-ranging) ---------- */
+/* The SAR search looks for the largest IDAC code that keeps the pin
+ * at or below R_TARGET_MV: well inside the 0..VDDA ADC range and
+ * clear of IDAC_1's compliance limit. Ranges are tried from the
+ * highest current down until the code has enough resolution.
+ */
+#define R_TARGET_MV        (CYDEV_VDDA_MV / 2)
+#define R_OPEN_MV          (CYDEV_VDDA_MV - 500)  /* IDAC out of compliance */
+#define R_MIN_CODE         (32u)
+#define R_AVG_SAMPLES      (8u)
+#define R_SETTLE_MS        (2u)
+#define R_STEP_TIMEOUT_MS  (5u)         /* a SAR step that never converts */
+
+typedef struct
+{
+    uint8  idacRange;   /* IDAC_1_RANGE_xxx */
+    uint16 lsb_na;      /* nominal current per code */
+    uint16 settle_us;   /* per SAR step; longer for the high-R ranges */
+} r_range_t;
+
+static const r_range_t rRanges[R_RANGE_COUNT] =
+{
+    { IDAC_1_RANGE_2mA,   8000u,  50u },
+    { IDAC_1_RANGE_255uA, 1000u, 150u },
+    { IDAC_1_RANGE_32uA,   125u, 500u }
+};
+
+/* ---------- C measurement ---------- */
+/* We measure in the small-signal region 2 mV .. 10 mV,
+ * because the node never rises above ~15 mV due to internal loading.
+ */
+#define IDAC_C_CODE        (12u)
+#define IDAC_C_LSB_NA      (125u)       /* IDAC_1 on its 32 uA range */
+#define IDAC_C_CURRENT_NA  (IDAC_C_CODE * IDAC_C_LSB_NA)
+
+/* new thresholds in the reachable range */
+#define DISCHARGE_MS       (50u)
+#define VSTART_MV          (2)
+#define VEND_MV            (10)
+#define TIMEOUT_MS         (500u)
+
+/* AMux_1 channels, in MEAS_ALL scan order */
+#define AMUX_CH_R          (0u)
+#define AMUX_CH_C          (1u)
+
+/* curve fit (MEAS:CFIT): dV/dt = I/C - V/(R C) fitted by least squares
+ * over differences CFIT_SPAN_DIV of the capture apart */
+#define CFIT_MIN_SAMPLES   (64u)
+#define CFIT_SPAN_DIV      (8u)
+
+/* ---------- diode / continuity / inductance (Pin_R) ---------- */
+#define D_DEFAULT_UA       (1000u)
+#define D_MAX_UA           (2040u)      /* 2 mA range, code 255 */
+#define D_SHORT_MV         (50)
+#define D_SETTLE_MS        (2u)
+/* V(I) / V(I/4): a junction moves ~36 mV, a resistor scales by 4 */
+#define D_RES_RATIO_Q8     (2u * 256u)
+
+/* continuity: 1 mA, beep below CONT_MAX_OHM */
+#define CONT_CODE          (125u)       /* 2 mA range: 1 mA */
+#define CONT_I_UA          (1000)
+#define CONT_MAX_OHM       (50)
+#define CONT_SETTLE_US     (100u)
+
+/* inductance: fixture puts L_RPAR_OHM across the jacks, so a current
+ * step starts at I*Rp and decays to I*(Rp||Rdc) with tau = L/(Rp+Rdc).
+ * One ADC sample is ~18 us, so L below ~5 mH is out of reach. The
+ * fixture has to come off again for R, D and CONT (README.md).
+ * Without it the step has nothing to start from: the pin runs up to
+ * I*Rdc, or into compliance for an open or high-Rdc coil, and the first
+ * sample lands well above I*Rp. A low-Rdc coil without the fixture
+ * settles within a sample and reads as L_TOO_SMALL. */
+#define L_RPAR_OHM         (100)
+#define L_CODE             (250u)       /* 2 mA range: 2 mA */
+#define L_I_UA             (2000)
+#define L_FIXTURE_MAX_UV   (L_I_UA * L_RPAR_OHM * 5 / 4)   /* IDAC + Rp tolerance */
+#define L_REST_MS          (5u)
+#define L_TIMEOUT_MS       (50u)
+#define L_TAIL             (16u)        /* samples averaged for V(inf) */
+#define L_MIN_STEP_UV      (20000)
+
+/* ---------- task ---------- */
+#define MEAS_TASK_STACK    (256u)
+#define MEAS_TASK_PRIO     (2u)       /* below scope/commands/replies, above TX */
+#define MEAS_QUEUE_LEN     (4u)
+
+typedef struct
+{
+    uint8  kind;
+    uint8  flags;
+    uint16 n;
+} meas_req_t;
+
+typedef enum
+{
+    MS_IDLE = 0,
+    MS_R_SETUP,
+    MS_R_SEARCH,
+    MS_R_STEP,
+    MS_R_SAMPLE,
+    MS_C_DISCHARGE,
+    MS_C_RELEASE,
+    MS_C_CHARGE,
+    MS_D_SETUP,
+    MS_D_SAMPLE,
+    MS_D_CHECK,
+    MS_CONT,
+    MS_CONT_READ,
+    MS_L_SETUP,
+    MS_L_STEP,
+    MS_L_WAIT
+} meas_state_t;
+
+static QueueHandle_t reqQueue;
+static QueueHandle_t resQueue;
+
+/* kernel objects, statically allocated (FreeRTOSConfig.h) */
+static StaticQueue_t reqQueueCtl, resQueueCtl;
+static uint8         reqQueueMem[MEAS_QUEUE_LEN * sizeof(meas_req_t)];
+static uint8         resQueueMem[MEAS_QUEUE_LEN * sizeof(meas_result_t)];
+static StaticTask_t  measTcb;
+static StackType_t   measStack[MEAS_TASK_STACK];
+
+static meas_state_t  state = MS_IDLE;
+static meas_result_t cur;
+static uint8         rIdx;
+static uint8         rBit;            /* SAR bit being tried */
+static uint8         rKeep;           /* skip the range search */
+static uint8         rawMode;         /* MEAS_F_RAW: no calibration */
+static volatile uint16 diodeUa = D_DEFAULT_UA;
+static uint8         dRange, dCode;
+static TickType_t    cHeadStart;      /* discharge already done (MEAS_ALL) */
+static uint32        contT0;
+
+static TaskHandle_t  measTask;
+static TaskHandle_t  resListener;     /* notified per posted result */
+
+/* ---------- charge capture (ADC_SAR_2 EOC interrupt) ----------
+ * The ADC free-runs off its own clock, so conversion n completes at
+ * n * Tconv with no software jitter. The ISR only counts conversions
+ * and notes where the thresholds were crossed, as a Q8 sample index;
+ * Tconv itself comes from DWT over the whole capture, so interrupt
+ * latency only shows up in the first and last timestamps and is
+ * spread over every conversion in between.
+ * Thresholds and samples are ADC counts in Q4 so the crossing is
+ * interpolated below one LSB.
+ */
+#define CAP_GOT_START      (0x01u)
+#define CAP_GOT_END        (0x02u)
+
+/* 18 ADC clocks per conversion at 12 bits */
+#define SAR2_CONV_NS       ((18u * 1000000u) / (ADC_SAR_2_CLOCK_FREQUENCY / 1000u))
+
+/* buffer mode: raw counts of every capDecim-th conversion, for curve
+ * work. CAP_MODE_GROW doubles capDecim (dropping every other stored
+ * sample) each time the buffer fills before the curve has levelled
+ * off, so one charge fills the buffer whatever the time constant. */
+#define CAP_MODE_THRESH    0u
+#define CAP_MODE_BUFFER    1u
+#define CAP_MODE_GROW      2u
+#define CAP_MODE_SETTLE    3u           /* capLen-th conversion to capBuf[0] */
+#define CAP_BUF_LEN        256u
+#define CAP_DECIM_MAX      256u
+
+static volatile uint8  capMode;
+static uint16          capLen;
+static uint16          capBuf[CAP_BUF_LEN];
+static volatile uint16 capStored;
+static volatile uint16 capDecim;
+
+static int32  thrStartQ4, thrEndQ4;
+
+static volatile uint32 capN;          /* conversions seen */
+static volatile uint32 capT0, capTLast;
+static volatile uint32 capStartQ8, capEndQ8;
+static volatile uint8  capFlags;
+static int32           capPrevQ4;
+
+/* =========================================================
+ *  helpers
+ * =======================================================*/
+
+/* one conversion from the free-running ADC_SAR_2, in uV. The one in
+ * flight may have started before the caller's settle time, so drop it. */
+static int32 sample_uv(void)
+{
+    (void)ADC_SAR_2_IsEndConversion(ADC_SAR_2_WAIT_FOR_RESULT);
+    (void)ADC_SAR_2_GetResult16();
+    (void)ADC_SAR_2_IsEndConversion(ADC_SAR_2_WAIT_FOR_RESULT);
+    return ADC_SAR_2_CountsTo_uVolts(ADC_SAR_2_GetResult16());
+}
+
+/* uV -> ADC_SAR_2 counts in Q4, inverse of ADC_SAR_2_CountsTo_uVolts */
+static int32 uv_to_counts_q4(int32 uv)
+{
+    int64 c = ((int64)uv * ADC_SAR_2_countsPer10Volt * 16) / ADC_SAR_2_10UV_COUNTS;
+    return (int32)c + ((int32)ADC_SAR_2_offset * 16);
+}
+
+/* Q8 sample position at which prev -> cur crossed thr */
+static uint32 crossing_q8(uint32 n, int32 curQ4, int32 thr)
+{
+    if ((n == 0u) || (curQ4 <= capPrevQ4))
+        return n << 8;
+    return ((n - 1u) << 8) +
+           (uint32)(((thr - capPrevQ4) << 8) / (curQ4 - capPrevQ4));
+}
+
+/* full buffer: has the rise over the last quarter dropped under 1/16
+ * of the whole rise? (8-sample sums, to see through the LSB steps) */
+static uint8 capture_levelled(void)
+{
+    uint32 first = 0u, q3 = 0u, last = 0u;
+    uint16 q = (capLen * 3u) / 4u;
+    uint8  i;
+
+    for (i = 0u; i < 8u; i++)
+    {
+        first += capBuf[i];
+        q3    += capBuf[q - 4u + i];
+        last  += capBuf[capLen - 8u + i];
+    }
+    if (last <= first)
+        return 0u;
+    return ((last - q3) * 16u < (last - first)) ? 1u : 0u;
+}
+
+/* one ADC_SAR_2 conversion of an armed capture, taken at t */
+static void capture_sample(uint32 t)
+{
+    int32  q4 = (int32)ADC_SAR_2_GetResult16() << 4;
+    uint32 n = capN;
+    BaseType_t woken = pdFALSE;
+
+    if (n == 0u)
+        capT0 = t;
+    capTLast = t;
+
+    if (capMode == CAP_MODE_SETTLE)
+    {
+        capN = n + 1u;
+        if (capN < capLen)
+            return;
+        capBuf[0] = (uint16)(q4 >> 4);
+        CyIntDisable(ADC_SAR_2_INTC_NUMBER);
+        vTaskNotifyGiveFromISR(measTask, &woken);
+        portYIELD_FROM_ISR(woken);
+        return;
+    }
+
+    if (capMode != CAP_MODE_THRESH)
+    {
+        capN = n + 1u;
+        if ((n & (capDecim - 1u)) != 0u)
+            return;
+
+        capBuf[capStored++] = (uint16)(q4 >> 4);
+        if (capStored < capLen)
+            return;
+
+        if ((capMode == CAP_MODE_GROW) && (capDecim < CAP_DECIM_MAX) &&
+            !capture_levelled())
+        {
+            /* keep the even samples: index j is now conversion j * 2d */
+            uint16 j;
+            for (j = 0u; j < capLen / 2u; j++)
+                capBuf[j] = capBuf[2u * j];
+            capStored = capLen / 2u;
+            capDecim <<= 1;
+            return;
+        }
+
+        IDAC_1_SetValue(0u);
+        CyIntDisable(ADC_SAR_2_INTC_NUMBER);
+        vTaskNotifyGiveFromISR(measTask, &woken);
+        portYIELD_FROM_ISR(woken);
+        return;
+    }
+
+    if (!(capFlags & CAP_GOT_START) && (q4 >= thrStartQ4))
+    {
+        capStartQ8 = crossing_q8(n, q4, thrStartQ4);
+        capFlags  |= CAP_GOT_START;
+    }
+    if ((capFlags & CAP_GOT_START) && (q4 >= thrEndQ4))
+    {
+        capEndQ8  = crossing_q8(n, q4, thrEndQ4);
+        capFlags |= CAP_GOT_END;
+
+        /* done: stop charging and stop taking interrupts */
+        IDAC_1_SetValue(0u);
+        CyIntDisable(ADC_SAR_2_INTC_NUMBER);
+        vTaskNotifyGiveFromISR(measTask, &woken);
+    }
+
+    capPrevQ4 = q4;
+    capN      = n + 1u;
+    portYIELD_FROM_ISR(woken);
+}
+
+/* hooked from ADC_SAR_2_ISR via cyapicallbacks.h; only enabled
+ * while a capture is armed */
+void ADC_SAR_2_ISR_InterruptCallback(void)
+{
+    uint32 t = stats_isr_begin();
+
+    capture_sample(t);
+    stats_isr_end(STATS_ISR_METER, t);
+}
+
+static void end_shot(void)
+{
+    state = MS_IDLE;
+}
+
+/* short Pin_C to ground through its own driver; independent of the
+ * mux, so it can run while another channel is being measured */
+static void c_discharge_begin(void)
+{
+    Pin_C_SetDriveMode(Pin_C_DM_STRONG);
+    Pin_C_Write(0u);
+}
+
+/* start taking ADC_SAR_2 interrupts; len only matters in buffer mode */
+static void capture_arm(uint8 mode, uint16 len)
+{
+    power_hold();   /* DWT timestamps: no sleep until capture_done */
+    capMode   = mode;
+    capLen    = (len > CAP_BUF_LEN) ? CAP_BUF_LEN : len;
+    capN      = 0u;
+    capStored = 0u;
+    capDecim  = 1u;
+    capFlags  = 0u;
+    capPrevQ4 = 0;
+    (void)ulTaskNotifyTake(pdTRUE, 0u);
+    CyIntClearPending(ADC_SAR_2_INTC_NUMBER);
+    CyIntEnable(ADC_SAR_2_INTC_NUMBER);
+}
+
+/* the task is back from waiting on an armed capture */
+static void capture_done(void)
+{
+    power_release();
+}
+
+/* settle the pin for us without holding the CPU: ADC_SAR_2 free-runs,
+ * so its conversions time the wait. The first EOC may belong to a
+ * conversion started before the change, so the one kept began at
+ * least us later. */
+static void settle_begin(uint16 us)
+{
+    uint32 conv = ((uint32)us * 1000u + SAR2_CONV_NS - 1u) / SAR2_CONV_NS;
+
+    capture_arm(CAP_MODE_SETTLE, (uint16)(conv + 2u));
+}
+
+/* block until the settled conversion is in; 0 if it never came */
+static uint8 settle_wait(int32 *uv)
+{
+    uint32 got = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(R_STEP_TIMEOUT_MS));
+
+    capture_done();
+    if (got == 0u)
+    {
+        CyIntDisable(ADC_SAR_2_INTC_NUMBER);
+        return 0u;
+    }
+    *uv = ADC_SAR_2_CountsTo_uVolts((int16)capBuf[0]);
+    return 1u;
+}
+
+/* one SAR step in range rIdx: try the next bit of the IDAC code */
+static void r_step_begin(void)
+{
+    IDAC_1_SetValue(cur.code | rBit);
+    settle_begin(rRanges[rIdx].settle_us);
+}
+
+/* conversion period of the last capture, ns in Q8 (stored samples
+ * are capDecim times this apart) */
+static uint32 capture_ns_q8(void)
+{
+    if (capN < 2u)
+        return 0u;
+    return (uint32)(((uint64)(capTLast - capT0) * 1000u * 256u) /
+                    ((uint64)(capN - 1u) * CYCLES_PER_US));
+}
+
+/* IDAC range/code closest to ua on Pin_R, rounded down */
+static void idac_for_ua(uint16 ua, uint8 *range, uint8 *code)
+{
+    if (ua <= 31u)
+    {
+        *range = IDAC_1_RANGE_32uA;
+        *code  = (uint8)(ua * 8u);
+    }
+    else if (ua <= 255u)
+    {
+        *range = IDAC_1_RANGE_255uA;
+        *code  = (uint8)ua;
+    }
+    else
+    {
+        *range = IDAC_1_RANGE_2mA;
+        *code  = (uint8)(((ua > D_MAX_UA) ? D_MAX_UA : ua) / 8u);
+    }
+}
+
+static int32 avg_uv(uint8 n)
+{
+    int32 uv = 0;
+    uint8 i;
+
+    for (i = 0u; i < n; i++)
+        uv += sample_uv();
+    return uv / (int32)n;
+}
+
+/* Q8 sample position where capBuf, taken as excess over base (counts
+ * in Q4), falls through h, searching from sample 'from'; 0 if never */
+static uint32 fall_q8(uint16 len, uint16 from, int32 base, int32 h)
+{
+    int32  a = ((int32)capBuf[from] << 4) - base;
+    uint16 k;
+
+    for (k = from + 1u; k < len; k++)
+    {
+        int32 b = ((int32)capBuf[k] << 4) - base;
+        if (b <= h)
+            return ((uint32)(k - 1u) << 8) +
+                   ((a > b) ? (uint32)(((a - h) << 8) / (a - b)) : 0u);
+        a = b;
+    }
+    return 0u;
+}
+
+/* integer square root (batch stddev, fit residual) */
+static uint32 isqrt64(uint64 v)
+{
+    uint64 r = 0u;
+    uint64 bit = (uint64)1u << 62;
+
+    while (bit > v)
+        bit >>= 2;
+    while (bit != 0u)
+    {
+        if (v >= r + bit)
+        {
+            v -= r + bit;
+            r  = (r >> 1) + bit;
+        }
+        else
+            r >>= 1;
+        bit >>= 2;
+    }
+    return (uint32)r;
+}
+
+/* num/den in Q16, scaled down first so neither side overflows */
+static int32 ratio_q16(int64 num, int64 den)
+{
+    while ((num > ((int64)1 << 46)) || (num < -((int64)1 << 46)) ||
+           (den > ((int64)1 << 46)) || (den < -((int64)1 << 46)))
+    {
+        num /= 2;
+        den /= 2;
+    }
+    return (den == 0) ? 0 : (int32)((num * 65536) / den);
+}
+
+static void finish_c(void)
+{
+    uint32 span, intervals;
+
+    CyIntDisable(ADC_SAR_2_INTC_NUMBER);
+    IDAC_1_SetValue(0u);  /* stop charging */
+
+    intervals = capN - 1u;
+    span      = capTLast - capT0;
+    if ((capFlags != (CAP_GOT_START | CAP_GOT_END)) || (capN < 2u) ||
+        (capEndQ8 <= capStartQ8))
+    {
+        cur.ok   = 0u;
+        cur.c_pf = -1;
+        end_shot();
+        return;
+    }
+
+    /* Q8 samples * (cycles per sample) -> ns */
+    cur.dt_ns = (uint32)(((uint64)(capEndQ8 - capStartQ8) * span * 1000u) /
+                         ((uint64)intervals * 256u * CYCLES_PER_US));
+
+    /* C = I dt / dV; nA * ns / mV = fF */
+    cur.c_pf = (int32)(((uint64)IDAC_C_CURRENT_NA * cur.dt_ns) /
+                       ((uint32)(VEND_MV - VSTART_MV) * 1000u));
+    if (!rawMode)
+        cur.c_pf = cal_apply(&calib_table()->c, cur.c_pf);
+    cur.ok   = 1u;
+    end_shot();
+}
+
+/* Least squares of y = b + m x with x = s[k] + s[k+D] (2V) and
+ * y = s[k+D] - s[k] (dV over D samples), all in ADC counts. Then
+ *   C = D ts I / (b LSB)      (ns * nA / uV = pF)
+ *   R C = -D ts / (2 m)
+ * and the fit residual RMS is reported relative to the mean y. */
+static void finish_cfit(void)
+{
+    uint16 len = capStored;
+    uint16 D, k, n;
+    int64  sx = 0, sy = 0, sxx = 0, sxy = 0, syy = 0, den;
+    int32  b_q16, m_q16, lsb_uv;
+    uint32 ts_ns, m2, corr;
+
+    CyIntDisable(ADC_SAR_2_INTC_NUMBER);
+    IDAC_1_SetValue(0u);
+    cur.ok = 0u;
+
+    if (len < CFIT_MIN_SAMPLES)
+    {
+        end_shot();
+        return;
+    }
+
+    D = len / CFIT_SPAN_DIV;
+    n = len - D;
+    for (k = 0u; k < n; k++)
+    {
+        int32 x = (int32)capBuf[k] + capBuf[k + D];
+        int32 y = (int32)capBuf[k + D] - capBuf[k];
+        sx  += x;
+        sy  += y;
+        sxx += (int64)x * x;
+        sxy += (int64)x * y;
+        syy += (int64)y * y;
+    }
+
+    den = (int64)n * sxx - sx * sx;
+    m_q16 = ratio_q16((int64)n * sxy - sx * sy, den);
+    b_q16 = (int32)(((sy << 16) - (int64)m_q16 * sx) / n);
+    if (b_q16 <= 0)
+    {
+        end_shot();
+        return;
+    }
+
+    ts_ns  = (uint32)(((uint64)capture_ns_q8() * capDecim) >> 8);
+    lsb_uv = ADC_SAR_2_CountsTo_uVolts(1000) - ADC_SAR_2_CountsTo_uVolts(0);  /* per 1000 */
+    cur.dt_ns = ts_ns * len;
+
+    /* D ts I / LSB first (~1e8 at most), then the Q16 divides. The
+     * secant over D samples of an exponential gives m = -tanh(D ts / 2RC)
+     * rather than -D ts / 2RC; dividing by atanh(m)/m = 1 + m^2/3 + m^4/5
+     * takes that bias out of C and RC. */
+    m2   = (uint32)(((int64)m_q16 * m_q16) >> 16);
+    corr = 65536u + m2 / 3u + (uint32)(((uint64)m2 * m2) >> 16) / 5u;
+    {
+        cur.c_pf = (int32)(((((((uint64)D * ts_ns * IDAC_C_CURRENT_NA * 1000u) / (uint32)lsb_uv)
+                            * 65536u) / (uint32)b_q16) * 65536u) / corr);
+    }
+    if (!rawMode)
+        cur.c_pf = cal_apply(&calib_table()->c, cur.c_pf);
+
+    /* leakage: R = RC / C, ns / pF = kohm; m >= 0 means none seen */
+    if ((m_q16 < 0) && (cur.c_pf > 0))
+    {
+        int64 rc_ns = ((((int64)D * ts_ns * 65536) / (2 * (int64)(-m_q16))) * 65536) / corr;
+        cur.leak_kohm = (int32)(rc_ns / cur.c_pf);
+    }
+    else
+        cur.leak_kohm = -1;
+
+    /* residual: syy - b sy - m sxy, Q16 */
+    {
+        int64  ss = (syy << 16) - (int64)b_q16 * sy - (int64)m_q16 * sxy;
+        uint32 rms_q8  = isqrt64((ss > 0) ? (uint64)(ss / n) : 0u);  /* sqrt(Q16) = Q8 */
+        int64  mean_q8 = (sy << 8) / n;
+        int64  pm      = (mean_q8 > 0) ? ((int64)rms_q8 * 1000) / mean_q8 : 65535;
+        cur.fit_pm = (uint16)((pm > 65535) ? 65535 : pm);
+    }
+    cur.ok = 1u;
+    end_shot();
+}
+
+static void finish_l(void)
+{
+    uint16 len = capStored;
+    int32  baseQ4 = 0, stepQ4, vinf, v0, rpar, rdc;
+    uint32 p1, p2, ns_q8;
+    uint64 l;
+    uint16 k;
+
+    CyIntDisable(ADC_SAR_2_INTC_NUMBER);
+    IDAC_1_SetValue(0u);
+    cur.ok = 0u;
+
+    if (len < capLen)
+    {
+        end_shot();
+        return;
+    }
+
+    /* V(inf) from the tail, kept in Q4 counts for the search */
+    for (k = len - L_TAIL; k < len; k++)
+        baseQ4 += capBuf[k];
+    baseQ4 = (baseQ4 << 4) / (int32)L_TAIL;
+    vinf   = ADC_SAR_2_CountsTo_uVolts((int16)(baseQ4 >> 4));
+    cur.mv = vinf / 1000;
+
+    /* sample 0 may straddle the step; measure from sample 1. From
+     * there the pin only falls from I*Rp. */
+    v0 = ADC_SAR_2_CountsTo_uVolts((int16)capBuf[1]);
+    if (v0 > L_FIXTURE_MAX_UV)
+    {
+        cur.cls = L_NO_FIXTURE;
+        end_shot();
+        return;
+    }
+    stepQ4 = ((int32)capBuf[1] << 4) - baseQ4;
+    if (stepQ4 < (uv_to_counts_q4(L_MIN_STEP_UV) - uv_to_counts_q4(0)))
+    {
+        cur.cls = L_TOO_SMALL;
+        end_shot();
+        return;
+    }
+    p1 = fall_q8(len - L_TAIL, 1u, baseQ4, stepQ4 / 2);
+    p2 = fall_q8(len - L_TAIL, 1u, baseQ4, stepQ4 / 4);
+    if (!p1 || !p2 || (p2 <= p1))
+    {
+        cur.cls = L_TOO_LARGE;
+        end_shot();
+        return;
+    }
+
+    /* p2 - p1 (Q8 samples) = tau * ln 2 */
+    ns_q8 = capture_ns_q8();
+    cur.dt_ns = (uint32)(((uint64)(p2 - p1) * ns_q8 * 1000000u) /
+                         ((uint64)256u * 256u * 693147u));
+
+    /* V(inf) = I * (Rp || Rdc); uV / uA = ohm */
+    rpar = vinf / L_I_UA;
+    if (rpar >= L_RPAR_OHM)
+    {
+        cur.cls = L_NO_PATH;
+        end_shot();
+        return;
+    }
+    rdc = (rpar <= 0) ? 0 : (L_RPAR_OHM * rpar) / (L_RPAR_OHM - rpar);
+
+    /* ns * ohm = nH */
+    l = (uint64)cur.dt_ns * (uint32)(L_RPAR_OHM + rdc);
+    cur.r_raw = rdc;
+    cur.l_nh  = (l > 0x7FFFFFFFu) ? 0x7FFFFFFF : (int32)l;
+    cur.cls   = L_OK;
+    cur.ok    = 1u;
+    end_shot();
+}
+
+/* =========================================================
+ *  measurement state machine
+ *  returns the ticks to sleep before the next step
+ * =======================================================*/
+static TickType_t meas_step(void)
+{
+    switch (state)
+    {
+    /* ---- resistance on Pin_R to GND ---- */
+    case MS_R_SETUP:
+        /* select Pin_R channel on mux */
+        AMux_1_FastSelect(AMUX_CH_R);
+
+        Pin_R_SetDriveMode(Pin_R_DM_ALG_HIZ);
+        IDAC_1_SetPolarity(IDAC_1_SOURCE);
+
+        if (rKeep)
+        {
+            /* later shots of a batch reuse the range the first one found */
+            IDAC_1_SetRange(rRanges[cur.range].idacRange);
+            IDAC_1_SetValue(cur.code);
+            state = MS_R_SAMPLE;
+            return pdMS_TO_TICKS(R_SETTLE_MS);
+        }
+        rIdx  = 0u;
+        state = MS_R_SEARCH;
+        return 0u;
+
+    case MS_R_SEARCH:
+        /* successive approximation on the IDAC code within one range:
+         * largest code with the pin still at or below R_TARGET_MV */
+        IDAC_1_SetRange(rRanges[rIdx].idacRange);
+        cur.code = 0u;
+        rBit     = 0x80u;
+        r_step_begin();
+        state = MS_R_STEP;
+        return 0u;
+
+    case MS_R_STEP:
+    {
+        /* one bit per step, blocked while the pin settles */
+        int32 uv;
+
+        if (settle_wait(&uv) && (uv <= (R_TARGET_MV * 1000)))
+            cur.code |= rBit;
+        rBit >>= 1;
+        if (rBit != 0u)
+        {
+            r_step_begin();
+            return 0u;
+        }
+
+        IDAC_1_SetValue(cur.code);
+        if ((cur.code >= R_MIN_CODE) || (rIdx == (R_RANGE_COUNT - 1u)))
+        {
+            cur.range = rIdx;
+            state     = MS_R_SAMPLE;
+            return pdMS_TO_TICKS(R_SETTLE_MS);
+        }
+        rIdx++;
+        state = MS_R_SEARCH;
+        return 0u;
+    }
+
+    case MS_R_SAMPLE:
+    {
+        int32  uv = avg_uv(R_AVG_SAMPLES);
+        uint32 i_na;
+
+        IDAC_1_SetValue(0u);
+
+        cur.mv = uv / 1000;
+        i_na   = (uint32)cur.code * rRanges[cur.range].lsb_na;
+
+        if ((i_na == 0u) || (cur.mv >= R_OPEN_MV))
+        {
+            /* nothing (or beyond 20 Mohm) on the pin */
+            cur.ok    = 0u;
+            cur.r_raw = -1;
+            cur.r_ohm = -1;
+            end_shot();
+            return 0u;
+        }
+
+        if (uv < 0)
+            uv = 0;
+        /* uV / nA = kohm */
+        cur.r_raw = (int32)(((int64)uv * 1000) / i_na);
+        cur.r_ohm = rawMode ? cur.r_raw :
+                    cal_apply(&calib_table()->r[cur.range], cur.r_raw);
+        if (cur.r_ohm < 0)
+            cur.r_ohm = 0;
+        cur.ok = 1u;
+        end_shot();
+        return 0u;
+    }
+
+    /* ---- capacitance on Pin_C to GND ---- */
+    case MS_C_DISCHARGE:
+    {
+        TickType_t d = pdMS_TO_TICKS(DISCHARGE_MS);
+
+        /* select Pin_C channel */
+        AMux_1_FastSelect(AMUX_CH_C);
+
+        /* fully discharge capacitor */
+        IDAC_1_SetValue(0u);
+        c_discharge_begin();
+
+        /* a scan has had the pin shorted while it measured Pin_R */
+        d = (cHeadStart < d) ? (d - cHeadStart) : 0u;
+        cHeadStart = 0u;
+        state = MS_C_RELEASE;
+        return d;
+    }
+
+    case MS_C_RELEASE:
+        /* high-Z; the timing runs from VSTART, not from here, so
+         * nothing has to settle before the IDAC starts */
+        Pin_C_SetDriveMode(Pin_C_DM_ALG_HIZ);
+
+        /* arm the capture before charging starts */
+        if (cur.kind == MEAS_CFIT)
+            capture_arm(CAP_MODE_GROW, CAP_BUF_LEN);
+        else
+            capture_arm(CAP_MODE_THRESH, 0u);
+
+        /* start charging with IDAC */
+        IDAC_1_SetRange(IDAC_1_RANGE_32uA);
+        IDAC_1_SetPolarity(IDAC_1_SOURCE);
+        IDAC_1_SetValue(IDAC_C_CODE);
+
+        state = MS_C_CHARGE;
+        return 0u;
+
+    case MS_C_CHARGE:
+        /* the ISR wakes us at VEND (or a levelled-off curve); otherwise
+         * give up, or fit what is there, at the timeout */
+        (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(TIMEOUT_MS));
+        capture_done();
+        if (cur.kind == MEAS_CFIT)
+            finish_cfit();
+        else
+            finish_c();
+        return 0u;
+
+    /* ---- diode forward voltage on Pin_R, anode at the pin ---- */
+    case MS_D_SETUP:
+        AMux_1_FastSelect(AMUX_CH_R);
+        Pin_R_SetDriveMode(Pin_R_DM_ALG_HIZ);
+        IDAC_1_SetPolarity(IDAC_1_SOURCE);
+
+        idac_for_ua(diodeUa, &dRange, &dCode);
+        IDAC_1_SetRange(dRange);
+        IDAC_1_SetValue(dCode);
+        cur.code = dCode;
+        state = MS_D_SAMPLE;
+        return pdMS_TO_TICKS(D_SETTLE_MS);
+
+    case MS_D_SAMPLE:
+        cur.mv = avg_uv(R_AVG_SAMPLES) / 1000;
+        if (cur.mv < D_SHORT_MV)
+        {
+            cur.cls = D_SHORT;
+            IDAC_1_SetValue(0u);
+            end_shot();
+            return 0u;
+        }
+        if (cur.mv >= R_OPEN_MV)
+        {
+            /* nothing there, or the diode is the other way round */
+            cur.cls = D_OPEN;
+            IDAC_1_SetValue(0u);
+            end_shot();
+            return 0u;
+        }
+        /* same part at a quarter of the current */
+        IDAC_1_SetValue(dCode / 4u);
+        state = MS_D_CHECK;
+        return pdMS_TO_TICKS(D_SETTLE_MS);
+
+    case MS_D_CHECK:
+    {
+        int32 mv4 = avg_uv(R_AVG_SAMPLES) / 1000;
+
+        IDAC_1_SetValue(0u);
+        cur.r_raw = mv4;
+        cur.cls = ((mv4 > 0) && (((uint32)cur.mv << 8) / (uint32)mv4 < D_RES_RATIO_Q8)) ?
+                  D_FWD : D_RES;
+        cur.ok  = 1u;
+        end_shot();
+        return 0u;
+    }
+
+    /* ---- continuity: one conversion at 1 mA, decision timed ---- */
+    case MS_CONT:
+        contT0 = cycles_now();
+
+        AMux_1_FastSelect(AMUX_CH_R);
+        Pin_R_SetDriveMode(Pin_R_DM_ALG_HIZ);
+        IDAC_1_SetPolarity(IDAC_1_SOURCE);
+        IDAC_1_SetRange(IDAC_1_RANGE_2mA);
+        IDAC_1_SetValue(CONT_CODE);
+        settle_begin(CONT_SETTLE_US);
+        state = MS_CONT_READ;
+        return 0u;
+
+    case MS_CONT_READ:
+    {
+        int32 uv;
+
+        cur.mv = settle_wait(&uv) ? (uv / 1000) : R_OPEN_MV;
+        IDAC_1_SetValue(0u);
+
+        cur.cls   = (cur.mv <= (CONT_MAX_OHM * CONT_I_UA / 1000)) ? CONT_CLOSED : CONT_OPEN;
+        cur.r_raw = (cur.mv < 0) ? 0 : (cur.mv * 1000) / CONT_I_UA;
+        cur.dt_ns = ((cycles_now() - contT0) * 1000u) / CYCLES_PER_US;
+        cur.ok    = 1u;
+        end_shot();
+        return 0u;
+    }
+
+    /* ---- inductance on Pin_R via step response ---- */
+    case MS_L_SETUP:
+        AMux_1_FastSelect(AMUX_CH_R);
+        Pin_R_SetDriveMode(Pin_R_DM_ALG_HIZ);
+        IDAC_1_SetPolarity(IDAC_1_SOURCE);
+        IDAC_1_SetRange(IDAC_1_RANGE_2mA);
+        IDAC_1_SetValue(0u);
+        state = MS_L_STEP;
+        return pdMS_TO_TICKS(L_REST_MS);     /* let any current die away */
+
+    case MS_L_STEP:
+        capture_arm(CAP_MODE_BUFFER, CAP_BUF_LEN);
+        IDAC_1_SetValue(L_CODE);
+        state = MS_L_WAIT;
+        return 0u;
+
+    case MS_L_WAIT:
+        (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(L_TIMEOUT_MS));
+        capture_done();
+        finish_l();
+        return 0u;
+
+    case MS_IDLE:
+    default:
+        state = MS_IDLE;
+        return 0u;
+    }
+}
+
+/* =========================================================
+ *  measurement task
+ * =======================================================*/
+/* one reading, run to completion */
+static void run_shot(uint8 kind)
+{
+    uint8  range = cur.range;
+    uint8  code  = cur.code;
+
+    memset(&cur, 0, sizeof(cur));
+    cur.kind  = kind;
+    cur.range = range;
+    cur.code  = code;
+    switch (kind)
+    {
+    case MEAS_C:
+    case MEAS_CFIT: state = MS_C_DISCHARGE; break;
+    case MEAS_D:    state = MS_D_SETUP;     break;
+    case MEAS_CONT: state = MS_CONT;        break;
+    case MEAS_L:    state = MS_L_SETUP;     break;
+    default:        state = MS_R_SETUP;     break;
+    }
+
+    while (state != MS_IDLE)
+    {
+        TickType_t d = meas_step();
+        if (d)
+            vTaskDelay(d);
+        else
+            taskYIELD();
+    }
+}
+
+static void post_result(void)
+{
+    if ((xQueueSend(resQueue, &cur, 0u) == pdPASS) && resListener)
+        xTaskNotifyGive(resListener);
+}
+
+/* MEAS_ALL: Pin_R then Pin_C, one result. Pin_C's discharge is the
+ * long settle of the scan (DISCHARGE_MS); it starts first and runs
+ * through the whole R reading, so the C channel only waits for what is
+ * left of it. Later scans of a request keep the R range. */
+static void run_scan(void)
+{
+    meas_result_t r;
+    TickType_t    t0;
+    uint32        c0;
+
+    power_hold();   /* scan_us is DWT time across task delays */
+    c0 = cycles_now();
+    c_discharge_begin();
+    t0 = xTaskGetTickCount();
+
+    run_shot(MEAS_R);
+    r = cur;
+    if (cur.ok)
+        rKeep = 1u;
+
+    cHeadStart = xTaskGetTickCount() - t0;
+    run_shot(MEAS_C);
+
+    /* R part of the record, C part as it came back */
+    cur.kind    = MEAS_ALL;
+    cur.ch_ok   = (uint8)((r.ok ? (1u << AMUX_CH_R) : 0u) |
+                          (cur.ok ? (1u << AMUX_CH_C) : 0u));
+    cur.ok      = (cur.ch_ok != 0u) ? 1u : 0u;
+    cur.mv      = r.mv;
+    cur.range   = r.range;
+    cur.code    = r.code;
+    cur.r_raw   = r.r_raw;
+    cur.r_ohm   = r.r_ohm;
+    cur.scan_us = (cycles_now() - c0) / CYCLES_PER_US;
+    power_release();
+}
+
+/* the number a batch or stream reports for the current shot */
+static int32 shot_value(void)
+{
+    switch (cur.kind)
+    {
+    case MEAS_C:
+    case MEAS_CFIT: return cur.c_pf;
+    case MEAS_L:    return cur.l_nh;
+    case MEAS_D:
+    case MEAS_CONT: return cur.mv;
+    default:        return cur.r_ohm;
+    }
+}
+
+/* N readings back to back, reduced to one result (see shot_value for
+ * units); the sums run on offsets from the first good reading so the
+ * squares stay inside 64 bits. */
+static void run_batch(uint8 kind, uint16 n)
+{
+    int32  v0 = 0, vmin = 0, vmax = 0;
+    int64  sum = 0, sumsq = 0;
+    uint16 good = 0u, fails = 0u, i;
+
+    rKeep = 0u;
+    for (i = 0u; i < n; i++)
+    {
+        int32 v, d;
+
+        run_shot(kind);
+        if (!cur.ok)
+        {
+            fails++;
+            continue;
+        }
+        v = shot_value();
+        if (good == 0u)
+        {
+            v0 = vmin = vmax = v;
+            rKeep = 1u;
+        }
+        if (v < vmin) vmin = v;
+        if (v > vmax) vmax = v;
+        d      = v - v0;
+        sum   += d;
+        sumsq += (int64)d * d;
+        good++;
+    }
+    rKeep = 0u;
+
+    cur.n     = good;
+    cur.fails = fails;
+    cur.ok    = (good > 0u) ? 1u : 0u;
+    if (good)
+    {
+        int64 mean_d = sum / good;
+        int64 var    = 0;
+
+        if (good > 1u)
+            var = (sumsq - mean_d * sum) / (good - 1u);
+        cur.mean = v0 + (int32)mean_d;
+        cur.sd   = (int32)isqrt64((var > 0) ? (uint64)var : 0u);
+        cur.min  = vmin;
+        cur.max  = vmax;
+    }
+}
+
+/* ---------- continuous streaming (METER:R / METER:C) ----------
+ * Between requests the task measures streamKind every streamPeriod
+ * ticks and posts each result flagged MEAS_F_STREAM. One-off requests
+ * still get served in between; they just push the next slot out.
+ */
+#define STREAM_OFF         0xFFu
+
+static uint8      streamKind = STREAM_OFF;
+static TickType_t streamPeriod;
+static TickType_t streamNext;
+static uint16     streamSeq;
+
+static void stream_shot(void)
+{
+    TickType_t now;
+
+    rawMode = 0u;
+    rKeep   = 0u;
+    run_shot(streamKind);
+
+    now       = xTaskGetTickCount();
+    cur.flags = MEAS_F_STREAM;
+    cur.seq   = streamSeq++;
+    cur.t_ms  = (uint32)(now * portTICK_PERIOD_MS);
+    post_result();                          /* full: dropped, seq shows it */
+
+    streamNext += streamPeriod;
+    if ((TickType_t)(now - streamNext) < (TickType_t)(portMAX_DELAY / 2u))
+        streamNext = now + streamPeriod;    /* fell behind: skip, don't burst */
+}
+
+static void meas_task(void *arg)
+{
+    meas_req_t req;
+    (void)arg;
+
+    for (;;)
+    {
+        TickType_t wait = portMAX_DELAY;
+
+        if (streamKind != STREAM_OFF)
+        {
+            TickType_t now = xTaskGetTickCount();
+            TickType_t due = streamNext - now;
+            wait = (due < (TickType_t)(portMAX_DELAY / 2u)) ? due : 0u;
+        }
+
+        if (xQueueReceive(reqQueue, &req, wait) != pdPASS)
+        {
+            stream_shot();
+            continue;
+        }
+
+        if (req.flags & MEAS_F_STREAM)
+        {
+            /* stream control: n is the period in ms */
+            streamKind   = (req.kind == MEAS_R || req.kind == MEAS_C) ? req.kind : STREAM_OFF;
+            streamPeriod = pdMS_TO_TICKS(req.n);
+            streamNext   = xTaskGetTickCount();
+            streamSeq    = 0u;
+            continue;
+        }
+
+        rawMode = (req.flags & MEAS_F_RAW) ? 1u : 0u;
+
+        if (req.kind == MEAS_ALL)
+        {
+            /* every scan is posted; no statistics across channels */
+            uint16 i;
+
+            rKeep = 0u;
+            for (i = 0u; i < ((req.n > 1u) ? req.n : 1u); i++)
+            {
+                run_scan();
+                cur.flags = req.flags;
+                post_result();
+            }
+            rKeep = 0u;
+            continue;
+        }
+
+        if (req.n <= 1u)
+        {
+            rKeep = 0u;
+            run_shot(req.kind);
+        }
+        else
+            run_batch(req.kind, req.n);
+
+        cur.flags = req.flags;
+        post_result();
+    }
+}
+
+/* =========================================================
+ *  public API
+ * =======================================================*/
+void meter_start(void)
+{
+    cycles_init();
+
+    thrStartQ4 = uv_to_counts_q4(VSTART_MV * 1000);
+    thrEndQ4   = uv_to_counts_q4(VEND_MV * 1000);
+
+    reqQueue = xQueueCreateStatic(MEAS_QUEUE_LEN, sizeof(meas_req_t),
+                                  reqQueueMem, &reqQueueCtl);
+    resQueue = xQueueCreateStatic(MEAS_QUEUE_LEN, sizeof(meas_result_t),
+                                  resQueueMem, &resQueueCtl);
+    measTask = xTaskCreateStatic(meas_task, "MEAS", MEAS_TASK_STACK, NULL,
+                                 MEAS_TASK_PRIO, measStack, &measTcb);
+}
+
+uint8 meter_request(uint8 kind, uint16 n, uint8 flags)
+{
+    meas_req_t req;
+
+    req.kind  = kind;
+    req.flags = flags;
+    req.n     = (n > MEAS_BATCH_MAX) ? MEAS_BATCH_MAX : n;
+    return (xQueueSend(reqQueue, &req, 0u) == pdPASS) ? 1u : 0u;
+}
+
+uint8 meter_stream(uint8 kind, uint16 period_ms)
+{
+    meas_req_t req;
+
+    req.kind  = kind;
+    req.flags = MEAS_F_STREAM;
+    req.n     = period_ms;
+    return (xQueueSend(reqQueue, &req, 0u) == pdPASS) ? 1u : 0u;
+}
+
+void meter_set_diode_current(uint16 ua)
+{
+    diodeUa = (ua == 0u) ? D_DEFAULT_UA : ((ua > D_MAX_UA) ? D_MAX_UA : ua);
+}
+
+void meter_notify(TaskHandle_t task)
+{
+    resListener = task;
+}
+
+uint8 meter_get_result(meas_result_t *res, uint32 wait_ms)
+{
+    return (xQueueReceive(resQueue, res, pdMS_TO_TICKS(wait_ms)) == pdPASS) ? 1u : 0u;
+}
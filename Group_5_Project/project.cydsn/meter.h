@@ -0,0 +1,100 @@
+#ifndef METER_H
+#define METER_H
+
+#include <cytypes.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* ---------- R/C meter (ADC_SAR_2 + AMux_1 + IDAC_1) ---------- */
+#define MEAS_R             0u
+#define MEAS_C             1u
+#define MEAS_D             2u         /* diode forward voltage */
+#define MEAS_CONT          3u         /* continuity */
+#define MEAS_L             4u         /* inductance */
+#define MEAS_CFIT          5u         /* C from a fit of the whole charge curve */
+#define MEAS_ALL           6u         /* R then C in one scan, one result */
+
+/* meas_result_t.cls */
+#define D_FWD              0u         /* junction, anode at the pin */
+#define D_OPEN             1u         /* open, or reversed */
+#define D_SHORT            2u
+#define D_RES              3u         /* conducts, but scales like a resistor */
+#define CONT_OPEN          0u
+#define CONT_CLOSED        1u
+#define L_OK               0u
+#define L_TOO_SMALL        1u         /* tau under one ADC sample */
+#define L_TOO_LARGE        2u         /* no decay inside the capture */
+#define L_NO_PATH          3u         /* no DC path: not an inductor */
+#define L_NO_FIXTURE       4u         /* step far above I*Rp: no Rp fitted */
+
+/* R ranges, highest IDAC current first */
+#define R_RANGE_2MA        0u
+#define R_RANGE_255UA      1u
+#define R_RANGE_32UA       2u
+#define R_RANGE_COUNT      3u
+
+#define MEAS_BATCH_MAX     1024u
+
+/* request flags */
+#define MEAS_F_RAW         0x01u      /* skip calibration (CAL points) */
+#define MEAS_F_STREAM      0x02u      /* result: METER stream record */
+
+typedef struct
+{
+    uint8  kind;        /* MEAS_R / MEAS_C */
+    uint8  flags;       /* MEAS_F_xxx of the request */
+    uint8  ok;
+    int32  mv;          /* R, D, CONT: pin voltage; L: settled voltage */
+    uint8  range;       /* R: R_RANGE_xxx used */
+    uint8  code;        /* R: IDAC code the search settled on */
+    uint8  cls;         /* D / CONT / L: outcome, see above */
+    int32  r_raw;       /* R: uncalibrated ohms; L: DC resistance;
+                           D: mV at a quarter of the current; CONT: ohms */
+    int32  r_ohm;       /* R: calibrated ohms (raw with MEAS_F_RAW), -1 if open */
+    uint32 dt_ns;       /* C: VSTART -> VEND charge time; L: tau;
+                           CONT: decision time; CFIT: capture length */
+    int32  l_nh;        /* L: inductance */
+    int32  leak_kohm;   /* CFIT: parallel leakage, -1 if none seen */
+    uint16 fit_pm;      /* CFIT: residual RMS, per mille of the mean slope */
+    int32  c_pf;        /* C: calibrated pF (raw with MEAS_F_RAW), -1 on timeout */
+
+    /* MEAS_ALL: R fields from the Pin_R channel, C fields from Pin_C */
+    uint8  ch_ok;       /* bit per AMux_1 channel that read */
+    uint32 scan_us;     /* whole scan, first setup to last sample */
+
+    /* batch (n > 1) only: ohms for R, pF for C, over the good shots */
+    uint16 n;
+    uint16 fails;
+    int32  mean, sd, min, max;
+
+    /* stream records only */
+    uint16 seq;
+    uint32 t_ms;        /* tick time the reading finished */
+} meas_result_t;
+
+/* creates the measurement task; call before vTaskStartScheduler() */
+void  meter_start(void);
+
+/* queue a measurement of n readings (1 = single shot, the result
+ * fields as before; more = statistics only). MEAS_ALL runs n scans and
+ * posts each one. Returns 0 if the request queue is full. */
+uint8 meter_request(uint8 kind, uint16 n, uint8 flags);
+
+/* start continuous readings of kind every period_ms (0: back to back),
+ * or stop them with kind = anything else. Returns 0 if the request
+ * queue is full. */
+uint8 meter_stream(uint8 kind, uint16 period_ms);
+
+/* forward current for MEAS_D, 0 = default (1 mA) */
+void  meter_set_diode_current(uint16 ua);
+
+/* task to get a direct-to-task notification (give) for every result
+ * posted, so it can sleep on its notification count instead of the
+ * result queue; NULL for none */
+void  meter_notify(TaskHandle_t task);
+
+/* fetch the next finished result, waiting up to wait_ms for one;
+ * returns 0 if none came */
+uint8 meter_get_result(meas_result_t *res, uint32 wait_ms);
+
+#endif /* METER_H */
@@ -0,0 +1,76 @@
+#include <project.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "power.h"
+#include "wavegen.h"
+
+/* Neither CyPmSleep nor CyPmAltAct: Sleep stops the clocks the scope
+ * ADC, the generator timer and the UART run on, and Alternate Active
+ * disables the CPU clock domain, SysTick with it, so the port would
+ * lose the ticks it sleeps for. A plain WFI in Active stops the core
+ * only, which is what the port's tickless code is written for. */
+
+#if ((POWER_WAKE_LATENCY_CYC * 4u) > (BCLK__BUS_CLK__HZ / WAVE_MAX_RATE_HZ))
+    #error "a wake from sleep must take under a quarter of a generator step"
+#endif
+
+static volatile uint8  holdCount;
+static uint32          sleeps;
+static uint32          sleepTicks;
+static uint64          sleepCycles;
+static uint32          sleepLoad;      /* SysTick reload of this sleep */
+
+void power_hold(void)
+{
+    taskENTER_CRITICAL();
+    holdCount++;
+    taskEXIT_CRITICAL();
+}
+
+void power_release(void)
+{
+    taskENTER_CRITICAL();
+    if (holdCount)
+        holdCount--;
+    taskEXIT_CRITICAL();
+}
+
+uint8 power_may_sleep(void)
+{
+    return (holdCount == 0u) ? 1u : 0u;
+}
+
+void power_pre_sleep(uint32 idle_ticks)
+{
+    sleeps++;
+    sleepTicks += idle_ticks;
+    sleepLoad   = SysTick->LOAD;   /* the port has just restarted it */
+}
+
+/* SysTick counts down from sleepLoad; if it reached 0 the tick is
+ * pending and it has started over. CTRL is not read: that would clear
+ * the COUNTFLAG the port looks at next. */
+void power_post_sleep(void)
+{
+    uint32 left = SysTick->VAL;
+
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+        sleepCycles += (uint64)sleepLoad + 1u + (sleepLoad - left);
+    else
+        sleepCycles += sleepLoad - left;
+}
+
+uint32 power_sleep_count(void)
+{
+    return sleeps;
+}
+
+uint32 power_sleep_ticks(void)
+{
+    return sleepTicks;
+}
+
+uint64 power_sleep_cycles(void)
+{
+    return sleepCycles;
+}
@@ -0,0 +1,39 @@
+#ifndef POWER_H
+#define POWER_H
+
+#include <cytypes.h>
+
+/* ---------- low power idle ----------
+ * FreeRTOS tickless idle (FreeRTOSConfig.h) reloads SysTick for the
+ * idle time when every task is blocked, and the CPU waits in WFI until
+ * the next interrupt or that SysTick. The power manager stays in
+ * Active: only the core stops, so SysTick keeps time across the sleep
+ * and the scope ADC, WaveTimer/VDAC8_1 and UART carry on. The scope ADC
+ * (RUN:0) and WaveTimer (EN:0) stop when not in use; either one running
+ * wakes the CPU on every sample.
+ */
+
+/* wake budget, CPU cycles from the interrupt that ends a sleep to its
+ * vector: WFI exit, power_post_sleep, the port's cpsie, exception entry */
+#define POWER_WAKE_LATENCY_CYC   64u
+
+/* DWT stops with the CPU clock: anything timing with cycles_now()
+ * across a block holds sleep off for that long. Nests; task context. */
+void   power_hold(void);
+void   power_release(void);
+
+/* portSUPPRESS_TICKS_AND_SLEEP gate, with the scheduler suspended */
+uint8  power_may_sleep(void);
+
+/* configPRE/POST_SLEEP_PROCESSING, interrupts masked, either side of
+ * the port's WFI */
+void   power_pre_sleep(uint32 idle_ticks);
+void   power_post_sleep(void);
+
+/* sleeps entered, ticks they were allowed to last, and SysTick counts
+ * (CPU cycles) they really lasted */
+uint32 power_sleep_count(void);
+uint32 power_sleep_ticks(void);
+uint64 power_sleep_cycles(void);
+
+#endif /* POWER_H */
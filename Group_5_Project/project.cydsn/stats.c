@@ -0,0 +1,67 @@
+#include <project.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stats.h"
+
+stats_isr_t statsIsr[STATS_ISR_COUNT];
+
+static uint32 resetTick;
+
+/* DWT extension for the run-time clock */
+static uint32 rtLast;
+static uint32 rtHigh;
+
+void stats_isr_get(uint8 id, stats_isr_t *out)
+{
+    uint8 intr = CyEnterCriticalSection();
+    *out = statsIsr[id];
+    CyExitCriticalSection(intr);
+}
+
+void stats_reset(void)
+{
+    uint8 i;
+    uint8 intr = CyEnterCriticalSection();
+
+    for (i = 0u; i < STATS_ISR_COUNT; i++)
+    {
+        statsIsr[i].n   = 0u;
+        statsIsr[i].min = 0xFFFFFFFFu;
+        statsIsr[i].max = 0u;
+        statsIsr[i].sum = 0u;
+    }
+    CyExitCriticalSection(intr);
+    resetTick = xTaskGetTickCount();
+}
+
+uint32 stats_since(void)
+{
+    return resetTick;
+}
+
+/* vTaskStartScheduler; meter_start() has normally started DWT already
+ * and zeroing it here would upset a running measurement */
+void stats_runtime_init(void)
+{
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk))
+        cycles_init();
+    rtLast = cycles_now();
+    rtHigh = 0u;
+    stats_reset();
+}
+
+/* called on every context switch; also from uxTaskGetSystemState with
+ * the scheduler merely suspended, hence the critical section */
+uint32 stats_runtime(void)
+{
+    uint32 now, v;
+    uint8  intr = CyEnterCriticalSection();
+
+    now = cycles_now();
+    if (now < rtLast)
+        rtHigh++;
+    rtLast = now;
+    v = (rtHigh << (32u - STATS_RUNTIME_SHIFT)) | (now >> STATS_RUNTIME_SHIFT);
+    CyExitCriticalSection(intr);
+    return v;
+}
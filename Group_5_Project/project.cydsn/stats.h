@@ -0,0 +1,57 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <cytypes.h>
+#include "cpu_cycles.h"
+
+/* ---------- runtime counters (STATS command) ----------
+ * Each instrumented ISR brackets its body with stats_isr_begin() /
+ * stats_isr_end(); the cost is two DWT reads and a few adds. Counts
+ * are CPU cycles. The FreeRTOS run-time stats clock is DWT as well,
+ * extended past its 179 s wrap.
+ */
+#define STATS_ISR_SCOPE    0u         /* isr_adc, ADC_SAR_1 sample */
+#define STATS_ISR_WAVE     1u         /* isr_wave, generator step */
+#define STATS_ISR_METER    2u         /* ADC_SAR_2 EOC, meter capture */
+#define STATS_ISR_UART     3u         /* UART RX */
+#define STATS_ISR_COUNT    4u
+
+typedef struct
+{
+    uint32 n;
+    uint32 min, max;
+    uint64 sum;
+} stats_isr_t;
+
+extern stats_isr_t statsIsr[STATS_ISR_COUNT];
+
+static inline uint32 stats_isr_begin(void)
+{
+    return cycles_now();
+}
+
+static inline void stats_isr_end(uint8 id, uint32 t0)
+{
+    stats_isr_t *s = &statsIsr[id];
+    uint32       d = cycles_now() - t0;
+
+    s->n++;
+    s->sum += d;
+    if (d > s->max) s->max = d;
+    if (d < s->min) s->min = d;
+}
+
+/* consistent copy for the reporting task */
+void   stats_isr_get(uint8 id, stats_isr_t *out);
+void   stats_reset(void);
+
+/* tick count at the last stats_reset(), for load figures */
+uint32 stats_since(void);
+
+/* portCONFIGURE_TIMER_FOR_RUN_TIME_STATS / portGET_RUN_TIME_COUNTER_VALUE:
+ * DWT cycles / 256 (10.7 us at 24 MHz), wraps after ~12.7 h */
+#define STATS_RUNTIME_SHIFT  8u
+void   stats_runtime_init(void);
+uint32 stats_runtime(void);
+
+#endif /* STATS_H */
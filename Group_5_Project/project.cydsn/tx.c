@@ -0,0 +1,249 @@
+#include <project.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "message_buffer.h"
+#include "tx.h"
+#include "log.h"
+
+/* UART_PutArray spins on the 4-byte TX FIFO (there is no TX
+ * interrupt), so the TX task runs at the lowest application priority
+ * and streams frames and results with the time nobody else wants.
+ * A queued reply lifts it to TX_CTRL_PRIO, above the measurement task,
+ * until TX_CH_CTRL is empty again: that spin is bounded by the reply
+ * traffic, and a reply waits for the message on the wire, not for MEAS. */
+#define TX_TASK_STACK      (128u)
+#define TX_TASK_PRIO       (1u)
+#define TX_CTRL_PRIO       (3u)
+
+/* bytes of buffer per class; each message costs 4 more for its length.
+ * TX_CH_DEBUG has no buffer: it is the log ring. */
+#define TX_CTRL_BUF_LEN    (512u)
+#define TX_MEAS_BUF_LEN    (512u)
+#define TX_FRAME_BUF_LEN   (2u * (TX_MSG_MAX + 4u))
+
+/* replies and results wait this long for room before they are dropped */
+#define TX_PUTS_WAIT_MS    (50u)
+
+/* ---------- bandwidth caps ----------
+ * Token bucket per class in bytes/s of the 11520 B/s link, 0 = none.
+ * A class past its cap yields to the classes after it; a soft cap
+ * still sends when nothing else is waiting, a hard one does not, which
+ * rate limits log records (the ring fills and records are dropped).
+ * Tokens are kept in 1/1000 byte so 1 ms refills are not lost.
+ */
+#define TX_BURST_BYTES     (512)
+
+typedef struct
+{
+    uint16 rate;                      /* bytes/s, 0 = uncapped */
+    uint8  hard;
+} tx_cap_t;
+
+static const tx_cap_t txCap[TX_CH_COUNT] =
+{
+    { 0u,    0u },                    /* CTRL */
+    { 6000u, 0u },                    /* MEAS */
+    { 9000u, 0u },                    /* FRAME */
+    { 800u,  1u },                    /* DEBUG */
+};
+
+static MessageBufferHandle_t txBuf[TX_CH_DEBUG];
+static TaskHandle_t          txTask;
+static int32                 txTokens[TX_CH_COUNT];
+static TickType_t            txRefill;
+
+/* kernel objects, statically allocated; a message buffer needs one
+ * byte more than its size */
+static StaticMessageBuffer_t txBufCtl[TX_CH_DEBUG];
+static uint8                 txCtrlMem[TX_CTRL_BUF_LEN + 1u];
+static uint8                 txMeasMem[TX_MEAS_BUF_LEN + 1u];
+static uint8                 txFrameMem[TX_FRAME_BUF_LEN + 1u];
+static StaticTask_t          txTcb;
+static StackType_t           txStack[TX_TASK_STACK];
+static uint8                 txOut[TX_MSG_MAX];
+
+/* STATS; each class has one writer, so plain increments */
+static uint32                txSent[TX_CH_COUNT];
+static uint32                txDropped[TX_CH_COUNT];
+static uint32                txBytes[TX_CH_COUNT];
+
+/* UART_PutArray takes at most 255 bytes */
+static void tx_write(const uint8 *p, size_t n)
+{
+    while (n)
+    {
+        uint8 k = (n > 255u) ? 255u : (uint8)n;
+        UART_PutArray(p, k);
+        p += k;
+        n -= k;
+    }
+}
+
+static void tx_refill(void)
+{
+    TickType_t now = xTaskGetTickCount();
+    uint32     ms  = (uint32)(now - txRefill) * portTICK_PERIOD_MS;
+    uint8      ch;
+
+    if (ms == 0u)
+        return;
+    txRefill = now;
+    if (ms > 1000u)
+        ms = 1000u;
+    for (ch = 0u; ch < TX_CH_COUNT; ch++)
+    {
+        txTokens[ch] += (int32)(txCap[ch].rate * ms);
+        if (txTokens[ch] > TX_BURST_BYTES * 1000)
+            txTokens[ch] = TX_BURST_BYTES * 1000;
+    }
+}
+
+static uint8 tx_empty(uint8 ch)
+{
+    if (ch == TX_CH_DEBUG)
+        return log_pending() ? 0u : 1u;
+    return xMessageBufferIsEmpty(txBuf[ch]) ? 1u : 0u;
+}
+
+/* next class to send, TX_CH_COUNT if none may; *wait is how long
+ * until a hard-capped class with data has tokens again */
+static uint8 tx_pick(TickType_t *wait)
+{
+    uint8 ch;
+
+    *wait = portMAX_DELAY;
+    for (ch = 0u; ch < TX_CH_COUNT; ch++)
+    {
+        if (tx_empty(ch))
+            continue;
+        if ((txCap[ch].rate == 0u) || (txTokens[ch] > 0))
+            return ch;
+    }
+    for (ch = 0u; ch < TX_CH_COUNT; ch++)
+    {
+        if (tx_empty(ch))
+            continue;
+        if (!txCap[ch].hard)
+            return ch;
+        *wait = pdMS_TO_TICKS((uint32)(-txTokens[ch]) / txCap[ch].rate) + 1u;
+    }
+    return TX_CH_COUNT;
+}
+
+static void tx_task(void *arg)
+{
+    (void)arg;
+
+    txRefill = xTaskGetTickCount();
+    for (;;)
+    {
+        TickType_t wait;
+        size_t     n;
+        uint8      ch;
+
+        /* replies out: back to base priority. With the scheduler held,
+         * tx_send cannot queue one and lift us in between. */
+        if (uxTaskPriorityGet(NULL) != TX_TASK_PRIO)
+        {
+            vTaskSuspendAll();
+            if (tx_empty(TX_CH_CTRL))
+                vTaskPrioritySet(NULL, TX_TASK_PRIO);
+            (void)xTaskResumeAll();
+        }
+
+        tx_refill();
+        ch = tx_pick(&wait);
+        if (ch == TX_CH_COUNT)
+        {
+            /* writers and log_write notify after every message */
+            (void)ulTaskNotifyTake(pdTRUE, wait);
+            continue;
+        }
+
+        if (ch == TX_CH_DEBUG)
+        {
+            n = log_take(txOut);
+            txSent[ch]++;
+        }
+        else
+            n = xMessageBufferReceive(txBuf[ch], txOut, sizeof(txOut), 0u);
+        tx_write(txOut, n);
+        txBytes[ch] += n;
+        if (txCap[ch].rate)
+            txTokens[ch] -= (int32)(n * 1000u);
+    }
+}
+
+/* =========================================================
+ *  public API
+ * =======================================================*/
+void tx_start(void)
+{
+    uint8 ch;
+
+    txBuf[TX_CH_CTRL]  = xMessageBufferCreateStatic(TX_CTRL_BUF_LEN, txCtrlMem,
+                                                    &txBufCtl[TX_CH_CTRL]);
+    txBuf[TX_CH_MEAS]  = xMessageBufferCreateStatic(TX_MEAS_BUF_LEN, txMeasMem,
+                                                    &txBufCtl[TX_CH_MEAS]);
+    txBuf[TX_CH_FRAME] = xMessageBufferCreateStatic(TX_FRAME_BUF_LEN, txFrameMem,
+                                                    &txBufCtl[TX_CH_FRAME]);
+    for (ch = 0u; ch < TX_CH_COUNT; ch++)
+        txTokens[ch] = TX_BURST_BYTES * 1000;
+    txTask = xTaskCreateStatic(tx_task, "TX", TX_TASK_STACK, NULL, TX_TASK_PRIO,
+                               txStack, &txTcb);
+}
+
+uint8 tx_send(uint8 ch, const void *p, uint16 len, uint32 wait_ms)
+{
+    if ((ch >= TX_CH_DEBUG) || (len == 0u) || (len > TX_MSG_MAX))
+        return 0u;
+    if (xMessageBufferSend(txBuf[ch], p, len, pdMS_TO_TICKS(wait_ms)) != len)
+    {
+        txDropped[ch]++;
+        return 0u;
+    }
+    txSent[ch]++;
+    if (ch == TX_CH_CTRL)
+        vTaskPrioritySet(txTask, TX_CTRL_PRIO);
+    xTaskNotifyGive(txTask);
+    return 1u;
+}
+
+uint8 tx_line(uint8 ch, const char *s)
+{
+    return tx_send(ch, s, (uint16)strlen(s), TX_PUTS_WAIT_MS);
+}
+
+uint8 tx_puts(const char *s)
+{
+    return tx_line(TX_CH_CTRL, s);
+}
+
+void tx_counts(uint8 ch, uint32 *sent, uint32 *dropped)
+{
+    if (ch >= TX_CH_COUNT)
+        return;
+    *sent    = txSent[ch];
+    *dropped = (ch == TX_CH_DEBUG) ? log_dropped() : txDropped[ch];
+}
+
+void tx_kick(void)
+{
+    BaseType_t woken = pdFALSE;
+
+    if (txTask == NULL)
+        return;
+    if (__get_IPSR() == 0u)
+    {
+        xTaskNotifyGive(txTask);
+        return;
+    }
+    vTaskNotifyGiveFromISR(txTask, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+uint32 tx_bytes(uint8 ch)
+{
+    return (ch < TX_CH_COUNT) ? txBytes[ch] : 0u;
+}
@@ -0,0 +1,47 @@
+#ifndef TX_H
+#define TX_H
+
+#include <cytypes.h>
+
+/* ---------- UART transmit scheduler ----------
+ * Every byte to the host goes through here. Each class is a FreeRTOS
+ * message buffer with exactly one writing task (the log ring for
+ * TX_CH_DEBUG, see log.h), sent in this order:
+ *   TX_CH_CTRL   replies, READY, CAL, STATS (command task; main()
+ *                before the scheduler starts)
+ *   TX_CH_MEAS   measurement results and METER records (command task)
+ *   TX_CH_FRAME  scope record chunks (scope task)
+ *   TX_CH_DEBUG  log records (any task, ISRs up to the syscall ceiling)
+ * The TX task sends whole messages, so a chunk is never split by a
+ * line, and picks the first class with data that is within its
+ * bandwidth cap. A reply waits at most for the message on the wire.
+ */
+#define TX_CH_CTRL         0u
+#define TX_CH_MEAS         1u
+#define TX_CH_FRAME        2u
+#define TX_CH_DEBUG        3u
+#define TX_CH_COUNT        4u
+
+#define TX_MSG_MAX         256u       /* largest single message */
+
+/* creates the buffers and the TX task; before anything is sent */
+void  tx_start(void);
+
+/* queue one message; waits up to wait_ms for room, 0 if dropped.
+ * Not for TX_CH_DEBUG, which is fed by LOG(). */
+uint8 tx_send(uint8 ch, const void *p, uint16 len, uint32 wait_ms);
+
+/* a NUL-terminated line */
+uint8 tx_line(uint8 ch, const char *s);
+
+/* a line on TX_CH_CTRL */
+uint8 tx_puts(const char *s);
+
+/* messages queued / dropped and bytes sent on a class since boot */
+void  tx_counts(uint8 ch, uint32 *sent, uint32 *dropped);
+uint32 tx_bytes(uint8 ch);
+
+/* wake the TX task for new log records; task or ISR context */
+void  tx_kick(void);
+
+#endif /* TX_H */
@@ -0,0 +1,27 @@
+/* Generated by Python_Scripts/gen_wave_tables.py - do not edit.
+ * Re-run the script after changing TABLE_LENGTHS.
+ */
+#ifndef WAVE_TABLES_H
+#define WAVE_TABLES_H
+
+#include <cytypes.h>
+
+/* one entry per resolution: 16, 32, 64, 128, 256, 512, 1024 points */
+#define WAVE_TABLE_COUNT      (7u)
+#define WAVE_TABLE_MIN_LEN    (16u)
+#define WAVE_TABLE_MAX_LEN    (1024u)
+
+typedef struct
+{
+    uint16       len;
+    const uint8 *sine;
+    const uint8 *tri;
+    const uint8 *sqr;
+} wave_table_set_t;
+
+extern const wave_table_set_t wave_tables[WAVE_TABLE_COUNT];
+
+/* smallest table with at least len points (largest one if len is too big) */
+const wave_table_set_t *wave_table_for_len(uint16 len);
+
+#endif /* WAVE_TABLES_H */
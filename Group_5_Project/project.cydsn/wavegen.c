@@ -0,0 +1,481 @@
+#include <project.h>
+#include <stdint.h>
+#include <string.h>
+#include "wavegen.h"
+#include "wave_tables.h"
+#include "stats.h"
+
+/* ---------- waveform LUT ----------
+ * base tables are const in flash (wave_tables.c); only the
+ * scaled copy that the ISR reads lives in SRAM, as Q8.8 VDAC
+ * codes so interpolation and dither keep the sub-LSB part.
+ * Sized for the longest table, set_frequency picks how much is used.
+ */
+static uint16 waveLUT[WAVE_TABLE_MAX_LEN];
+static uint16 lutLen = 128u;
+
+/* phase accumulator: the top log2(lutLen) bits index waveLUT,
+ * the 8 bits below them are the interpolation fraction
+ */
+static volatile uint32 wavePhase = 0u;
+static volatile uint32 phaseInc  = 0u;
+static volatile uint8  lutShift  = 25u;   /* 32 - log2(lutLen) */
+static volatile uint8  interpOn  = 0u;
+
+static volatile uint8  waveMode     = WAVE_SINE;
+static volatile uint8  wave_enabled = 0u;
+
+/* bumped each time the phase accumulator wraps (one output period) */
+static volatile uint32 syncCount = 0u;
+
+/* ---------- output scaling ---------- */
+static uint16 amp_mvpp   = VDAC_FULL_MV;
+static int16  offset_mv  = (int16)(VDAC_FULL_MV / 2u);
+static uint16 clipCount  = 0u;
+
+/* noise modes bypass the LUT; the ISR scales with these instead */
+static volatile int32  noiseOffQ8  = 0;
+static volatile int32  noiseGainQ8 = 0;
+
+/* ---------- multi-tone ---------- */
+typedef struct
+{
+    uint16 harm;        /* multiple of FREQ, 0 = slot unused */
+    uint16 amp_q15;
+    uint16 phase;       /* in 1024ths of a turn */
+} tone_t;
+
+static tone_t tones[WAVE_MAX_TONES] = { { 1u, 32767u, 0u } };
+
+/* ---------- TPDF dither / noise source ---------- */
+static volatile uint8  ditherOn  = 0u;
+static volatile uint32 lfsrState = 0x2545F491u;   /* xorshift32, never 0 */
+
+static uint32 waveFreq = 1000u;
+
+/* ---------- entry jitter ----------
+ * jit and the stamps belong to the ISR while jitArmed; the task side
+ * touches them with interrupts masked (isr_wave is above BASEPRI) */
+static volatile uint8  jitArmed = 0u;
+static uint8           jitFirst;
+static uint32          jitTarget;
+static uint32          jitPrev;         /* last entry */
+static uint32          jitGrid;         /* ideal time of the next entry */
+static wave_jitter_t   jit;
+static uint32          timerPeriod = 1u; /* WaveTimer clocks per step */
+
+#define CYC_PER_WAVE_CLK   (BCLK__BUS_CLK__HZ / WAVE_CLK_HZ)
+
+/* base table byte (0..255) -> Q15 sample in -1..+1 */
+#define Q15_FROM_U8(x)     (((((int32)(x) << 1) - 255) * 257) / 2)
+#define Q8_MAX             ((int32)255 << 8)
+
+#define IS_NOISE(m)        (((m) == WAVE_NOISE) || ((m) == WAVE_GNOISE))
+
+/* xorshift32: full-period 32-bit linear feedback generator, 3 shifts */
+static inline uint32 lfsr_next(void)
+{
+    uint32 r = lfsrState;
+    r ^= r << 13;
+    r ^= r >> 17;
+    r ^= r << 5;
+    lfsrState = r;
+    return r;
+}
+
+/* unnormalised sum of the active tones at LUT point i, Q15 per tone */
+static int32 multitone_at(uint16 i)
+{
+    const uint8 *sine = wave_tables[WAVE_TABLE_COUNT - 1u].sine;
+    uint32 step = WAVE_TABLE_MAX_LEN / lutLen;
+    int32  acc  = 0;
+    uint8  k;
+
+    for (k = 0u; k < WAVE_MAX_TONES; k++)
+    {
+        uint32 idx;
+
+        /* tones at or above Nyquist of the current table alias */
+        if ((tones[k].harm == 0u) || (tones[k].harm >= (lutLen / 2u)))
+            continue;
+
+        idx = ((uint32)tones[k].harm * i * step + tones[k].phase)
+              & (WAVE_TABLE_MAX_LEN - 1u);
+        acc += (Q15_FROM_U8(sine[idx]) * (int32)tones[k].amp_q15) >> 15;
+    }
+    return acc;
+}
+
+/* =========================================================
+ *  build waveform LUT from the const base tables
+ * =======================================================*/
+static void rebuild_lut(void)
+{
+    uint16 i;
+    uint16 clipped = 0u;
+    int32  peak    = 0;
+    const wave_table_set_t *set = wave_table_for_len(lutLen);
+    const uint8 *src = (waveMode == WAVE_TRI) ? set->tri :
+                       (waveMode == WAVE_SQR) ? set->sqr : set->sine;
+
+    /* mV -> Q8.8 codes: x256 / VDAC_MV_PER_LSB; half of Vpp is the peak */
+    int32 off_q8  = ((int32)offset_mv * 256) / (int32)VDAC_MV_PER_LSB;
+    int32 gain_q8 = ((int32)amp_mvpp * 128) / (int32)VDAC_MV_PER_LSB;
+
+    if (IS_NOISE(waveMode))
+    {
+        noiseOffQ8  = off_q8;
+        noiseGainQ8 = gain_q8;
+        clipCount   = ((off_q8 < gain_q8) || ((off_q8 + gain_q8) > Q8_MAX)) ? 1u : 0u;
+        return;
+    }
+
+    /* the composite is normalised to its own peak, so AMPMV sets its Vpp */
+    if (waveMode == WAVE_MULTI)
+    {
+        for (i = 0u; i < lutLen; i++)
+        {
+            int32 m = multitone_at(i);
+            if (m < 0) m = -m;
+            if (m > peak) peak = m;
+        }
+    }
+
+    for (i = 0u; i < lutLen; i++)
+    {
+        int32 q15, v;
+
+        if (waveMode == WAVE_MULTI)
+            q15 = (peak > 0) ? (int32)(((int64)multitone_at(i) * 32767) / peak) : 0;
+        else
+            q15 = Q15_FROM_U8(src[i]);
+
+        v = off_q8 + ((q15 * gain_q8) >> 15);
+
+        if (v < 0)           { v = 0;      clipped++; }
+        else if (v > Q8_MAX) { v = Q8_MAX; clipped++; }
+
+        waveLUT[i] = (uint16)v;
+    }
+
+    clipCount = clipped;
+}
+
+/* legacy 0..100 % control: full-scale swing anchored at 0 V */
+void set_amplitude(uint8 a)
+{
+    if (a > 100u) a = 100u;
+    amp_mvpp  = (uint16)(((uint32)a * VDAC_FULL_MV) / 100u);
+    offset_mv = (int16)(amp_mvpp / 2u);
+    rebuild_lut();
+}
+
+void set_amplitude_mv(uint16 mvpp)
+{
+    if (mvpp > VDAC_FULL_MV) mvpp = VDAC_FULL_MV;
+    amp_mvpp = mvpp;
+    rebuild_lut();
+}
+
+void set_offset_mv(int16 mv)
+{
+    if (mv < -(int16)VDAC_FULL_MV) mv = -(int16)VDAC_FULL_MV;
+    if (mv >  (int16)VDAC_FULL_MV) mv =  (int16)VDAC_FULL_MV;
+    offset_mv = mv;
+    rebuild_lut();
+}
+
+void set_dither(uint8 on)
+{
+    ditherOn = on ? 1u : 0u;
+}
+
+uint16 wavegen_clip_count(void)
+{
+    return clipCount;
+}
+
+uint32 wavegen_sync_count(void)
+{
+    return syncCount;
+}
+
+void set_wave(uint8 m)
+{
+    uint8 was_noise = IS_NOISE(waveMode);
+
+    if (m > WAVE_MULTI) m = WAVE_SINE;
+    waveMode = m;
+
+    /* noise runs the timer at the full budget, the others at f * len */
+    if (was_noise != IS_NOISE(m))
+        set_frequency(waveFreq);
+    rebuild_lut();
+}
+
+void set_tone(uint8 slot, uint16 harm, uint8 amp_pct, uint16 phase_deg)
+{
+    if (slot >= WAVE_MAX_TONES)
+        return;
+    if (amp_pct > 100u) amp_pct = 100u;
+
+    tones[slot].harm    = harm;
+    tones[slot].amp_q15 = (uint16)(((uint32)amp_pct * 32767u) / 100u);
+    tones[slot].phase   = (uint16)((((uint32)phase_deg % 360u) * WAVE_TABLE_MAX_LEN) / 360u);
+
+    if (waveMode == WAVE_MULTI)
+        rebuild_lut();
+}
+
+void clear_tones(void)
+{
+    memset(tones, 0, sizeof(tones));
+    if (waveMode == WAVE_MULTI)
+        rebuild_lut();
+}
+
+/* WaveTimer and isr_wave only run while the output is on, so an idle
+ * generator does not wake the CPU out of tickless sleep
+ */
+void set_wave_enabled(uint8 en)
+{
+    if (en)
+    {
+        if (wave_enabled)
+            return;
+        wave_enabled = 1u;
+        isr_wave_ClearPending();
+        isr_wave_Enable();
+        WaveTimer_Start();
+    }
+    else
+    {
+        wave_enabled = 0u;
+        WaveTimer_Stop();
+        isr_wave_Disable();
+        wavegen_jitter_stop();
+        VDAC8_1_SetValue(0u);
+        wavePhase = 0u;
+    }
+}
+
+/* Picks the longest table (16..1024) that the sample budget can step
+ * through one entry per tick. Below WAVE_MAX_RATE_HZ / 1024 the full
+ * table still leaves budget over, so the timer runs at the budget and
+ * the ISR interpolates between entries instead.
+ */
+void set_frequency(uint32 f)
+{
+    uint16 len   = WAVE_TABLE_MAX_LEN;
+    uint8  shift = 22u;                   /* 32 - log2(1024) */
+    uint8  interp = 0u;
+    uint32 rate, p, inc;
+
+    if (f < WAVE_MIN_FREQ_HZ) f = WAVE_MIN_FREQ_HZ;
+    if (f > WAVE_MAX_FREQ_HZ) f = WAVE_MAX_FREQ_HZ;
+    waveFreq = f;
+
+    while ((len > WAVE_TABLE_MIN_LEN) && ((f * len) > WAVE_MAX_RATE_HZ))
+    {
+        len >>= 1;
+        shift++;
+    }
+
+    rate = f * len;
+    if (IS_NOISE(waveMode))
+        rate = WAVE_MAX_RATE_HZ;
+    else if ((len == WAVE_TABLE_MAX_LEN) && (rate < WAVE_MAX_RATE_HZ))
+    {
+        rate   = WAVE_MAX_RATE_HZ;
+        interp = 1u;
+    }
+
+    p = (WAVE_CLK_HZ + (rate / 2u)) / rate;
+    if (p == 0u) p = 1u;
+    if (p > 65536u) p = 65536u;
+
+    /* phase step for the rate the timer really produces, so the
+     * output frequency is exact even when p had to be rounded */
+    inc = (uint32)(((uint64)(f * p) << 32) / WAVE_CLK_HZ);
+
+    WaveTimer_Stop();
+    wavegen_jitter_stop();
+    timerPeriod = p;
+
+    if (len != lutLen)
+    {
+        lutLen = len;
+        rebuild_lut();
+    }
+    phaseInc = inc;
+    lutShift = shift;
+    interpOn = interp;
+
+    WaveTimer_WriteCounter(0u);
+    WaveTimer_WritePeriod((uint16)(p - 1u));
+    if (wave_enabled)
+        WaveTimer_Start();
+}
+
+/* =========================================================
+ *  WaveTimer ISR: function generator stepping
+ * =======================================================*/
+static void wave_step(void)
+{
+    uint32 ph;
+    uint16 idx;
+    int32  out;                           /* Q8.8 VDAC code */
+
+    (void)WaveTimer_ReadStatusRegister();
+
+    if (!wave_enabled)
+    {
+        VDAC8_1_SetValue(0u);
+        return;
+    }
+
+    if (waveMode == WAVE_NOISE)
+    {
+        int32 n = (int32)(int16)(lfsr_next() >> 16);
+        out = noiseOffQ8 + ((n * noiseGainQ8) >> 15);
+    }
+    else if (waveMode == WAVE_GNOISE)
+    {
+        /* sum of four uniform bytes (Irwin-Hall), peak = 3.45 sigma */
+        uint32 r = lfsr_next();
+        int32  n = (int32)(r & 0xFFu) + (int32)((r >> 8) & 0xFFu) +
+                   (int32)((r >> 16) & 0xFFu) + (int32)(r >> 24) - 510;
+        out = noiseOffQ8 + ((n * 64 * noiseGainQ8) >> 15);
+    }
+    else
+    {
+        ph = wavePhase + phaseInc;
+        if (ph < wavePhase)
+            syncCount++;
+        wavePhase = ph;
+
+        idx = (uint16)(ph >> lutShift);
+        out = waveLUT[idx];
+
+        if (interpOn)
+        {
+            /* interpOn implies the 1024-point table */
+            int32 next = waveLUT[(idx + 1u) & (WAVE_TABLE_MAX_LEN - 1u)];
+            int32 frac = (int32)((ph >> (lutShift - 8u)) & 0xFFu);
+            out += ((next - out) * frac) >> 8;
+        }
+    }
+
+    if (ditherOn)
+    {
+        uint32 r = lfsr_next();
+
+        /* TPDF: two uniform 1-LSB variates summed, +-1 LSB peak */
+        out += (int32)(r & 0xFFu) + (int32)((r >> 8) & 0xFFu) - 256;
+    }
+
+    out = (out + 128) >> 8;
+    if (out < 0)   out = 0;
+    if (out > 255) out = 255;
+
+    VDAC8_1_SetValue((uint8)out);
+}
+
+static void jitter_entry(uint32 t)
+{
+    int32 dev, tie, b;
+
+    if (jitFirst)
+    {
+        jitFirst = 0u;
+        jitPrev  = t;
+        jitGrid  = t + jit.period;
+        return;
+    }
+
+    dev = (int32)(t - jitPrev) - (int32)jit.period;
+    tie = (int32)(t - jitGrid);
+    jitPrev  = t;
+    jitGrid += jit.period;
+
+    if (dev < jit.dev_min) jit.dev_min = dev;
+    if (dev > jit.dev_max) jit.dev_max = dev;
+    if (tie < jit.tie_min) jit.tie_min = tie;
+    if (tie > jit.tie_max) jit.tie_max = tie;
+    if (dev > (int32)(jit.period / 2u))
+        jit.missed++;
+
+    b = dev + (int32)((WAVE_JIT_BINS / 2u) * WAVE_JIT_BIN_CYC);
+    if (b < 0) b = 0;
+    b /= (int32)WAVE_JIT_BIN_CYC;
+    if (b >= (int32)WAVE_JIT_BINS) b = (int32)WAVE_JIT_BINS - 1;
+    jit.hist[b]++;
+
+    if (++jit.n >= jitTarget)
+        jitArmed = 0u;
+}
+
+CY_ISR(WaveTimer_ISR)
+{
+    uint32 t0 = stats_isr_begin();
+
+    if (jitArmed)
+        jitter_entry(t0);
+    wave_step();
+    stats_isr_end(STATS_ISR_WAVE, t0);
+}
+
+/* =========================================================
+ *  entry jitter
+ * =======================================================*/
+void wavegen_jitter_start(uint32 n)
+{
+    uint8 intr = CyEnterCriticalSection();
+
+    memset(&jit, 0, sizeof(jit));
+    jit.period  = timerPeriod * CYC_PER_WAVE_CLK;
+    jit.dev_min = jit.tie_min = INT32_MAX;
+    jit.dev_max = jit.tie_max = INT32_MIN;
+    jitTarget   = n ? n : 1u;
+    jitFirst    = 1u;
+    jitArmed    = wave_enabled;   /* no timer, no entries */
+    CyExitCriticalSection(intr);
+}
+
+void wavegen_jitter_stop(void)
+{
+    jitArmed = 0u;
+}
+
+uint8 wavegen_jitter_busy(void)
+{
+    return jitArmed;
+}
+
+void wavegen_jitter_get(wave_jitter_t *out)
+{
+    uint8 intr = CyEnterCriticalSection();
+
+    *out = jit;
+    CyExitCriticalSection(intr);
+}
+
+/* =========================================================
+ *  bring-up: VDAC, WaveClock/WaveTimer and isr_wave
+ * =======================================================*/
+void wavegen_start(void)
+{
+    rebuild_lut();
+
+    VDAC8_1_Start();
+    VDAC8_1_SetValue(0u);
+    WaveClock_Start();
+
+    /* Start runs the component's Init once, before set_frequency
+     * writes the period; the timer then waits for EN:1 */
+    WaveTimer_Start();
+    WaveTimer_Stop();
+    isr_wave_StartEx(WaveTimer_ISR);
+    isr_wave_Disable();
+    set_frequency(1000u);
+}
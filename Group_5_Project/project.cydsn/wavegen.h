@@ -0,0 +1,78 @@
+#ifndef WAVEGEN_H
+#define WAVEGEN_H
+
+#include <cytypes.h>
+
+/* ---------- waveform generator (VDAC8_1 + WaveTimer) ---------- */
+#define WAVE_CLK_HZ        1000000u
+#define WAVE_MAX_RATE_HZ   62500u     /* sample budget for WaveTimer_ISR */
+#define WAVE_MIN_FREQ_HZ   1u
+#define WAVE_MAX_FREQ_HZ   3000u
+
+/* VDAC8_1 is on its 4 V range */
+#define VDAC_MV_PER_LSB    16u
+#define VDAC_FULL_MV       (255u * VDAC_MV_PER_LSB)   /* 4080 mV */
+
+/* waveMode values */
+#define WAVE_SINE          0u
+#define WAVE_TRI           1u
+#define WAVE_SQR           2u
+#define WAVE_NOISE         3u         /* uniform white noise */
+#define WAVE_GNOISE        4u         /* approx. Gaussian white noise */
+#define WAVE_MULTI         5u         /* sum of up to WAVE_MAX_TONES sines */
+
+#define WAVE_MAX_TONES     8u
+
+void  wavegen_start(void);
+
+void  set_frequency(uint32 f);
+void  set_amplitude(uint8 a);
+void  set_wave(uint8 m);
+void  set_wave_enabled(uint8 en);
+
+void  set_amplitude_mv(uint16 mvpp);
+void  set_offset_mv(int16 mv);
+void  set_dither(uint8 on);
+
+/* multi-tone slot: harm x FREQ, amp in % of the composite, phase in deg.
+ * harm 0 frees the slot. */
+void  set_tone(uint8 slot, uint16 harm, uint8 amp_pct, uint16 phase_deg);
+void  clear_tones(void);
+
+/* LUT points clipped at 0 / full scale by the last rebuild */
+uint16 wavegen_clip_count(void);
+
+/* sync event: increments once per output period while enabled
+ * (never in the noise modes). Safe to poll from other ISRs. */
+uint32 wavegen_sync_count(void);
+
+/* ---------- entry jitter (JITTER command) ----------
+ * While armed, each WaveTimer_ISR entry is stamped with DWT. The
+ * entry-to-entry interval minus the timer period goes into a histogram
+ * of WAVE_JIT_BINS bins of WAVE_JIT_BIN_CYC cycles centred on 0 (the
+ * end bins take the overflow); the entry time against the ideal grid
+ * from the first entry bounds the phase error. Counts are CPU cycles.
+ * DWT stops in sleep: hold it off (power_hold) for the run.
+ */
+#define WAVE_JIT_BINS      16u
+#define WAVE_JIT_BIN_CYC   8u         /* 333 ns at 24 MHz */
+
+typedef struct
+{
+    uint32 n;                         /* intervals measured */
+    uint32 period;                    /* timer period */
+    int32  dev_min, dev_max;          /* interval - period */
+    int32  tie_min, tie_max;          /* entry - ideal grid */
+    uint32 missed;                    /* intervals over 1.5 periods */
+    uint32 hist[WAVE_JIT_BINS];
+} wave_jitter_t;
+
+/* n intervals; retiming the timer (FREQ, noise on or off) or EN:0
+ * ends the run early. With the output off the timer is stopped and
+ * nothing is armed: busy is 0 at once and the result has n = 0. */
+void  wavegen_jitter_start(uint32 n);
+void  wavegen_jitter_stop(void);
+uint8 wavegen_jitter_busy(void);
+void  wavegen_jitter_get(wave_jitter_t *out);
+
+#endif /* WAVEGEN_H */
@@ -0,0 +1,68 @@
+"""
+Generates the host side of the firmware's tokenized log.
+
+The firmware sends LOG() records as a format id plus raw int32 arguments;
+the format strings themselves only exist in log_fmt.h. This script pulls
+the LOG_FORMATS(X) list out of that header, in order, and writes it to
+log_table.py, which main.py uses to print the records.
+
+Usage:
+    python gen_log_table.py              # project log_fmt.h -> log_table.py here
+    python gen_log_table.py <log_fmt.h> [<out.py>]
+"""
+import os
+import re
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+DEFAULT_HEADER = os.path.join(HERE, "..", "Group_5_Project", "project.cydsn",
+                              "log_fmt.h")
+DEFAULT_OUT = os.path.join(HERE, "log_table.py")
+
+BANNER = ('"""\n'
+          "Generated by Python_Scripts/gen_log_table.py from log_fmt.h - do not edit.\n"
+          "Re-run the script after changing LOG_FORMATS.\n"
+          '"""\n')
+
+ENTRY = re.compile(r'X\(\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)')
+
+
+# ---------------- parsing ----------------
+def read_formats(path):
+    with open(path) as f:
+        text = f.read()
+    start = text.find("#define LOG_FORMATS(X)")
+    if start < 0:
+        raise ValueError(f"no LOG_FORMATS(X) in {path}")
+    # the macro body runs to the first line without a continuation
+    body = []
+    for line in text[start:].splitlines():
+        body.append(line)
+        if not line.rstrip().endswith("\\"):
+            break
+    entries = ENTRY.findall("\n".join(body))
+    if not entries:
+        raise ValueError(f"LOG_FORMATS in {path} is empty")
+    return entries
+
+
+# ---------------- output ----------------
+def emit(entries):
+    rows = "\n".join(f"    ({name!r}, {fmt!r}),   # {i}"
+                     for i, (name, fmt) in enumerate(entries))
+    return BANNER + "\n# index = firmware log id: (name, printf format)\n" \
+        + "LOG_FORMATS = [\n" + rows + "\n]\n"
+
+
+def write(path, text):
+    # same line endings as the rest of Python_Scripts
+    with open(path, "w", newline="\r\n") as f:
+        f.write(text)
+    print(f"wrote {path}")
+
+
+# ---------------- main ----------------
+if __name__ == "__main__":
+    header = sys.argv[1] if len(sys.argv) > 1 else DEFAULT_HEADER
+    out = sys.argv[2] if len(sys.argv) > 2 else DEFAULT_OUT
+    write(out, emit(read_formats(header)))
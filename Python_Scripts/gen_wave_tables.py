@@ -0,0 +1,128 @@
+"""
+Generates the const waveform tables used by the PSoC function generator.
+
+The firmware used to build its sine/triangle/square tables at boot with a
+float Taylor series. The tables are now emitted here once, at every
+supported resolution, and linked into flash as `const` data.
+
+Usage:
+    python gen_wave_tables.py            # writes into ../Group_5_Project/project.cydsn
+    python gen_wave_tables.py <out_dir>
+"""
+import math
+import os
+import sys
+
+# ---------------- table config ----------------
+# must stay powers of two: the firmware indexes with shifts/masks
+TABLE_LENGTHS = [16, 32, 64, 128, 256, 512, 1024]
+
+DEFAULT_OUT_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                               "..", "Group_5_Project", "project.cydsn")
+
+BANNER = ("/* Generated by Python_Scripts/gen_wave_tables.py - do not edit.\n"
+          " * Re-run the script after changing TABLE_LENGTHS.\n"
+          " */\n")
+
+
+# ---------------- waveforms ----------------
+def sine(n):
+    out = []
+    for i in range(n):
+        v = int(round(128.0 + 127.0 * math.sin(2.0 * math.pi * i / n)))
+        out.append(min(max(v, 0), 255))
+    return out
+
+
+def tri(n):
+    h = n // 2
+    up = [(255 * i) // (h - 1) for i in range(h)]
+    down = [255 - (255 * i) // (h - 1) for i in range(h)]
+    return up + down
+
+
+def sqr(n):
+    h = n // 2
+    return [0] * h + [255] * (n - h)
+
+
+WAVES = [("sine", sine), ("tri", tri), ("sqr", sqr)]
+
+
+# ---------------- emitters ----------------
+def c_array(name, values):
+    lines = [f"static const uint8 {name}[{len(values)}u] = {{"]
+    for i in range(0, len(values), 16):
+        row = ", ".join(f"{v:3d}" for v in values[i:i + 16])
+        lines.append(f"    {row},")
+    lines[-1] = lines[-1].rstrip(",")
+    lines.append("};")
+    return "\n".join(lines)
+
+
+def emit_header():
+    lens = ", ".join(str(n) for n in TABLE_LENGTHS)
+    return BANNER + f"""#ifndef WAVE_TABLES_H
+#define WAVE_TABLES_H
+
+#include <cytypes.h>
+
+/* one entry per resolution: {lens} points */
+#define WAVE_TABLE_COUNT      ({len(TABLE_LENGTHS)}u)
+#define WAVE_TABLE_MIN_LEN    ({TABLE_LENGTHS[0]}u)
+#define WAVE_TABLE_MAX_LEN    ({TABLE_LENGTHS[-1]}u)
+
+typedef struct
+{{
+    uint16       len;
+    const uint8 *sine;
+    const uint8 *tri;
+    const uint8 *sqr;
+}} wave_table_set_t;
+
+extern const wave_table_set_t wave_tables[WAVE_TABLE_COUNT];
+
+/* smallest table with at least len points (largest one if len is too big) */
+const wave_table_set_t *wave_table_for_len(uint16 len);
+
+#endif /* WAVE_TABLES_H */
+"""
+
+
+def emit_source():
+    parts = [BANNER + '#include "wave_tables.h"\n']
+    for n in TABLE_LENGTHS:
+        for name, fn in WAVES:
+            parts.append(c_array(f"{name}_{n}", fn(n)) + "\n")
+
+    rows = ",\n".join(f"    {{ {n}u, sine_{n}, tri_{n}, sqr_{n} }}"
+                      for n in TABLE_LENGTHS)
+    parts.append("const wave_table_set_t wave_tables[WAVE_TABLE_COUNT] =\n{\n"
+                 + rows + "\n};\n")
+
+    parts.append("""const wave_table_set_t *wave_table_for_len(uint16 len)
+{
+    uint8 i;
+    for (i = 0u; i < (WAVE_TABLE_COUNT - 1u); i++)
+    {
+        if (wave_tables[i].len >= len)
+            break;
+    }
+    return &wave_tables[i];
+}
+""")
+    return "\n".join(parts)
+
+
+def write(path, text):
+    # PSoC Creator project files use CRLF
+    with open(path, "w", newline="\r\n") as f:
+        f.write(text)
+    print(f"wrote {path}")
+
+
+# ---------------- main ----------------
+if __name__ == "__main__":
+    out_dir = sys.argv[1] if len(sys.argv) > 1 else DEFAULT_OUT_DIR
+    write(os.path.join(out_dir, "wave_tables.h"), emit_header())
+    write(os.path.join(out_dir, "wave_tables.c"), emit_source())
@@ -0,0 +1,13 @@
+"""
+Generated by Python_Scripts/gen_log_table.py from log_fmt.h - do not edit.
+Re-run the script after changing LOG_FORMATS.
+"""
+
+# index = firmware log id: (name, printf format)
+LOG_FORMATS = [
+    ('LOG_DBG_R', 'DBG_R: mv=%d, range=%d, code=%d, Rraw=%d, Rcal=%d'),   # 0
+    ('LOG_DBG_C', 'DBG_C: ok=%d, dt=%d ns, C=%d pF'),   # 1
+    ('LOG_DBG_D', 'DBG_D: mv=%d, mv_quarter=%d, code=%d'),   # 2
+    ('LOG_DBG_L', 'DBG_L: tau=%d ns, rdc=%d, vinf=%d mv'),   # 3
+    ('LOG_DBG_CFIT', 'DBG_CFIT: span=%d ns, C=%d pF, leak=%d k, fit=%d'),   # 4
+]
@@ -1,19 +1,51 @@
 import serial
+import struct
+import sys
+import time
 import numpy as np
 import pyqtgraph as pg
 from pyqtgraph.Qt import QtCore, QtWidgets
 
+from log_table import LOG_FORMATS
+
 # ---------------- Serial config ----------------
 PORT = "COM7"     
 BAUD = 115200
-FRAME_SAMPLES = 252
+# scope record length (LEN:), samples; averaging keeps 32-bit sums,
+# so it has a quarter of the capture memory
+REC_DEFAULT_LEN = 252
+REC_MIN_LEN = 64
+REC_MAX_LEN = 32768
+REC_MAX_AVG_LEN = 8192
 SAMPLE_RATE_HZ = 30000.0
 
 TIME_WINDOW_S = 0.005
 N_PLOT = int(TIME_WINDOW_S * SAMPLE_RATE_HZ)
 
 FULL_SCALE_V = 5.0
-CAL_GAIN = 1.0
+CAL_GAIN = 1.0       # replaced by the firmware's CAL_SCOPE value
+
+VDAC_FULL_MV = 4080   # VDAC8_1 on its 4 V range, 16 mV/LSB
+
+AVG_MAX = 256         # coherent averaging limit in firmware
+
+R_RANGE_NAMES = ["2 mA", "255 µA", "32 µA"]   # index = firmware R_RANGE_xxx
+MEAS_BATCH_MAX = 1024  # readings per MEAS request in firmware
+
+# scope record chunk: 0xAA, <rec u8, total u16, offset u16, n u8>, n samples
+FRAME_MARK = 0xAA
+FRAME_HDR = struct.Struct("<BHHB")
+FRAME_CHUNK_MAX = 240
+
+# METER stream record: 0xAB, len, <kind u8, status u8, seq u16, t_ms u32, value i32>
+METER_MARK = 0xAB
+METER_REC = struct.Struct("<BBHIi")
+
+# LOG record: 0xAD, len, <id u8, t_ms u32>, up to 5 x i32 arguments;
+# formats come from log_fmt.h via gen_log_table.py
+LOG_MARK = 0xAD
+LOG_HDR = struct.Struct("<BI")
+LOG_MAX_ARGS = 5
 
 
 class ScopeFuncGenRC(QtWidgets.QWidget):
@@ -29,13 +61,28 @@ class ScopeFuncGenRC(QtWidgets.QWidget):
             print(f"Serial open failed: {e}")
 
         self.frame_state = "idle"
+        self.jitter_line = "JITTER:"
         self.pending_len = 0
+        self.pending_hdr = None
         self.pending_data = bytearray()
         self.line_buf = ""
+        self.r_range = None
+
+        # scope record being reassembled from its chunks
+        self.rec = None
+        self.rec_id = None
+        self.rec_total = 0
+
+        # METER streaming: CSV log of every record while a stream runs
+        self.meter_log = None
+        self.meter_seq = None
 
         # last raw frame (for save/export)
         self.last_frame = None
 
+        # STATS_* lines of the report in progress, shown at STATS:END
+        self.stats_lines = []
+
         # ---- plotting config (dark theme) ----
         pg.setConfigOptions(antialias=True)
         pg.setConfigOption('background', '#111111')
@@ -53,6 +100,9 @@ class ScopeFuncGenRC(QtWidgets.QWidget):
         self.timer.timeout.connect(self.poll_serial)
         self.timer.start(5)
 
+        # calibration lives on the board; ask for it in case READY was missed
+        self.send_line("CAL:SHOW")
+
     # ------------- UI -------------
     def init_ui(self):
         self.setWindowTitle("PSoC Lab Station")
@@ -76,8 +126,37 @@ class ScopeFuncGenRC(QtWidgets.QWidget):
         self.plot.setYRange(0, FULL_SCALE_V * CAL_GAIN)
         self.plot.setXRange(0, TIME_WINDOW_S * 1000.0)
         self.curve = self.plot.plot(pen=pg.mkPen(width=2))
+        # deep records: draw min/max per pixel, only what is in view
+        self.plot.setDownsampling(auto=True, mode='peak')
+        self.plot.setClipToView(True)
         left_panel.addWidget(self.plot, 1)
 
+        # Trigger / averaging
+        trig_row = QtWidgets.QHBoxLayout()
+        self.cb_run = QtWidgets.QCheckBox("Run")
+        self.cb_run.setChecked(True)
+        self.cb_run.setToolTip("off: the scope ADC stops and the board can sleep")
+        self.cb_run.toggled.connect(self.send_acq)
+        trig_row.addWidget(self.cb_run)
+        self.cb_sync = QtWidgets.QCheckBox("Sync to generator")
+        self.cb_sync.toggled.connect(self.send_acq)
+        trig_row.addWidget(self.cb_sync)
+        trig_row.addStretch()
+        trig_row.addWidget(QtWidgets.QLabel("Average"))
+        self.avg_spin = QtWidgets.QSpinBox()
+        self.avg_spin.setRange(1, AVG_MAX)
+        self.avg_spin.setValue(1)
+        self.avg_spin.valueChanged.connect(self.send_acq)
+        trig_row.addWidget(self.avg_spin)
+        trig_row.addWidget(QtWidgets.QLabel("Record"))
+        self.len_spin = QtWidgets.QSpinBox()
+        self.len_spin.setRange(REC_MIN_LEN, REC_MAX_LEN)
+        self.len_spin.setValue(REC_DEFAULT_LEN)
+        self.len_spin.setToolTip(f"samples per capture; {REC_MAX_AVG_LEN} max when averaging")
+        self.len_spin.editingFinished.connect(self.send_acq)
+        trig_row.addWidget(self.len_spin)
+        left_panel.addLayout(trig_row)
+
         main.addLayout(left_panel, 3)
 
         # ========= RIGHT: Controls =========
@@ -119,28 +198,48 @@ class ScopeFuncGenRC(QtWidgets.QWidget):
         gen_layout.addWidget(freq_group)
 
         # Amplitude
-        amp_group = QtWidgets.QGroupBox("Amplitude (%)")
+        amp_group = QtWidgets.QGroupBox("Amplitude (mVpp)")
         amp_group.setObjectName("Group")
         a_layout = QtWidgets.QVBoxLayout(amp_group)
 
-        self.amp_label = QtWidgets.QLabel("100 %")
+        self.amp_label = QtWidgets.QLabel(f"{VDAC_FULL_MV} mVpp")
         self.amp_label.setObjectName("ValueLabel")
         a_layout.addWidget(self.amp_label)
 
         self.amp_slider = QtWidgets.QSlider(QtCore.Qt.Horizontal)
-        self.amp_slider.setRange(0, 100)
-        self.amp_slider.setValue(100)
+        self.amp_slider.setRange(0, VDAC_FULL_MV)
+        self.amp_slider.setValue(VDAC_FULL_MV)
         self.amp_slider.valueChanged.connect(self.on_amp_change)
         a_layout.addWidget(self.amp_slider)
 
         a_ends = QtWidgets.QHBoxLayout()
         a_ends.addWidget(QtWidgets.QLabel("0"))
         a_ends.addStretch()
-        a_ends.addWidget(QtWidgets.QLabel("100"))
+        a_ends.addWidget(QtWidgets.QLabel(str(VDAC_FULL_MV)))
         a_layout.addLayout(a_ends)
 
         gen_layout.addWidget(amp_group)
 
+        # Offset
+        offs_group = QtWidgets.QGroupBox("Offset (mV)")
+        offs_group.setObjectName("Group")
+        o_layout = QtWidgets.QVBoxLayout(offs_group)
+
+        self.offs_label = QtWidgets.QLabel(f"{VDAC_FULL_MV // 2} mV")
+        self.offs_label.setObjectName("ValueLabel")
+        o_layout.addWidget(self.offs_label)
+
+        self.offs_slider = QtWidgets.QSlider(QtCore.Qt.Horizontal)
+        self.offs_slider.setRange(0, VDAC_FULL_MV)
+        self.offs_slider.setValue(VDAC_FULL_MV // 2)
+        self.offs_slider.valueChanged.connect(self.on_offs_change)
+        o_layout.addWidget(self.offs_slider)
+
+        self.cb_dither = QtWidgets.QCheckBox("TPDF dither")
+        o_layout.addWidget(self.cb_dither)
+
+        gen_layout.addWidget(offs_group)
+
         # Waveform
         wave_group = QtWidgets.QGroupBox("Waveform")
         wave_group.setObjectName("Group")
@@ -150,18 +249,32 @@ class ScopeFuncGenRC(QtWidgets.QWidget):
         self.rb_sine = QtWidgets.QRadioButton("Sine")
         self.rb_tri  = QtWidgets.QRadioButton("Triangle")
         self.rb_sqr  = QtWidgets.QRadioButton("Square")
+        self.rb_noise = QtWidgets.QRadioButton("Noise")
+        self.rb_multi = QtWidgets.QRadioButton("Multi-tone")
         self.rb_sine.setChecked(True)
 
         self.wave_var.addButton(self.rb_sine, 0)
         self.wave_var.addButton(self.rb_tri, 1)
         self.wave_var.addButton(self.rb_sqr, 2)
+        self.wave_var.addButton(self.rb_noise, 3)
+        self.wave_var.addButton(self.rb_multi, 5)
 
         w_layout.addWidget(self.rb_sine)
         w_layout.addWidget(self.rb_tri)
         w_layout.addWidget(self.rb_sqr)
+        w_layout.addWidget(self.rb_noise)
+        w_layout.addWidget(self.rb_multi)
 
         gen_layout.addWidget(wave_group)
 
+        # Multi-tone: "harm:amp%:phase" per tone, separated by ';'
+        tone_row = QtWidgets.QHBoxLayout()
+        tone_row.addWidget(QtWidgets.QLabel("Tones"))
+        self.tone_edit = QtWidgets.QLineEdit("1:100:0; 3:50:90")
+        self.tone_edit.setToolTip("harmonic:amplitude%:phase_deg; ... (max 8)")
+        tone_row.addWidget(self.tone_edit)
+        gen_layout.addLayout(tone_row)
+
         # Start/Stop
         btn_row = QtWidgets.QHBoxLayout()
         self.btn_start = QtWidgets.QPushButton("Start / Apply")
@@ -202,11 +315,72 @@ class ScopeFuncGenRC(QtWidgets.QWidget):
         self.label_C.setObjectName("BigValueLabel")
         self.btn_measC = QtWidgets.QPushButton("Measure C")
         self.btn_measC.clicked.connect(self.send_meas_c)
+        self.btn_fitC = QtWidgets.QPushButton("Fit C")
+        self.btn_fitC.setToolTip("Fit the whole charge curve: C, leakage, fit quality")
+        self.btn_fitC.clicked.connect(lambda: self.send_line(self.meas_cmd("CFIT")))
         cg_layout.addWidget(self.label_C)
         cg_layout.addStretch()
         cg_layout.addWidget(self.btn_measC)
+        cg_layout.addWidget(self.btn_fitC)
         meter_layout.addWidget(c_group)
 
+        # Diode / continuity / inductance on the R jacks
+        x_group = QtWidgets.QGroupBox("Component test (R jacks)")
+        x_group.setObjectName("Group")
+        xg_layout = QtWidgets.QVBoxLayout(x_group)
+        self.label_X = QtWidgets.QLabel("---")
+        self.label_X.setObjectName("BigValueLabel")
+        xg_layout.addWidget(self.label_X)
+        x_row = QtWidgets.QHBoxLayout()
+        self.diode_spin = QtWidgets.QSpinBox()
+        self.diode_spin.setRange(1, 2040)
+        self.diode_spin.setValue(1000)
+        self.diode_spin.setSuffix(" µA")
+        x_row.addWidget(self.diode_spin)
+        self.btn_diode = QtWidgets.QPushButton("Diode")
+        self.btn_diode.clicked.connect(self.send_meas_d)
+        x_row.addWidget(self.btn_diode)
+        self.btn_cont = QtWidgets.QPushButton("Continuity")
+        self.btn_cont.clicked.connect(lambda: self.send_line(self.meas_cmd("CONT")))
+        x_row.addWidget(self.btn_cont)
+        self.btn_ind = QtWidgets.QPushButton("Inductance")
+        self.btn_ind.setToolTip("Needs the 100 Ω fixture across the R jacks; "
+                                "take it off again for R, Diode and Continuity")
+        self.btn_ind.clicked.connect(lambda: self.send_line(self.meas_cmd("L")))
+        x_row.addWidget(self.btn_ind)
+        xg_layout.addLayout(x_row)
+        meter_layout.addWidget(x_group)
+
+        # Batch: N readings per request, firmware replies with statistics
+        batch_row = QtWidgets.QHBoxLayout()
+        batch_row.addWidget(QtWidgets.QLabel("Readings"))
+        self.shots_spin = QtWidgets.QSpinBox()
+        self.shots_spin.setRange(1, MEAS_BATCH_MAX)
+        self.shots_spin.setValue(1)
+        batch_row.addWidget(self.shots_spin)
+        batch_row.addStretch()
+        # R and C in one scan; with Readings > 1, one line per scan
+        self.btn_scan = QtWidgets.QPushButton("Scan R + C")
+        self.btn_scan.clicked.connect(lambda: self.send_line(self.meas_cmd("ALL")))
+        batch_row.addWidget(self.btn_scan)
+        meter_layout.addLayout(batch_row)
+
+        # Stream: firmware measures on its own and sends binary records
+        stream_row = QtWidgets.QHBoxLayout()
+        stream_row.addWidget(QtWidgets.QLabel("Stream"))
+        self.stream_combo = QtWidgets.QComboBox()
+        self.stream_combo.addItems(["Off", "R", "C"])
+        self.stream_combo.currentIndexChanged.connect(self.send_stream)
+        stream_row.addWidget(self.stream_combo)
+        stream_row.addWidget(QtWidgets.QLabel("every (ms)"))
+        self.stream_spin = QtWidgets.QSpinBox()
+        self.stream_spin.setRange(0, 60000)
+        self.stream_spin.setValue(100)
+        self.stream_spin.editingFinished.connect(self.send_stream)
+        stream_row.addWidget(self.stream_spin)
+        stream_row.addStretch()
+        meter_layout.addLayout(stream_row)
+
         right_panel.addWidget(meter_card)
 
         # --------- Save + Status + Quit ----------
@@ -223,11 +397,28 @@ class ScopeFuncGenRC(QtWidgets.QWidget):
         self.btn_quit.setObjectName("QuitButton")
         self.btn_save.clicked.connect(self.save_waveform)
         self.btn_quit.clicked.connect(self.quit_app)
+        self.btn_stats = QtWidgets.QPushButton("Stats")
+        self.btn_stats.clicked.connect(lambda: self.send_line("STATS"))
+        self.btn_stats_reset = QtWidgets.QPushButton("Reset Stats")
+        self.btn_stats_reset.clicked.connect(lambda: self.send_line("STATS:RESET"))
         btn_bar.addWidget(self.btn_save)
+        btn_bar.addWidget(self.btn_stats)
+        btn_bar.addWidget(self.btn_stats_reset)
+        self.btn_jitter = QtWidgets.QPushButton("Gen Jitter")
+        self.btn_jitter.clicked.connect(lambda: self.send_line("JITTER"))
+        btn_bar.addWidget(self.btn_jitter)
         btn_bar.addStretch()
         btn_bar.addWidget(self.btn_quit)
         bottom_layout.addLayout(btn_bar)
 
+        # firmware STATS report, filled in at STATS:END
+        self.stats_view = QtWidgets.QPlainTextEdit()
+        self.stats_view.setReadOnly(True)
+        self.stats_view.setStyleSheet('font-family: "Consolas", "DejaVu Sans Mono", monospace; font-size: 9pt;')
+        self.stats_view.setFixedHeight(160)
+        self.stats_view.hide()
+        bottom_layout.addWidget(self.stats_view)
+
         self.status_label = QtWidgets.QLabel("Status: Ready")
         self.status_label.setObjectName("StatusLabel")
         bottom_layout.addWidget(self.status_label)
@@ -344,13 +535,20 @@ class ScopeFuncGenRC(QtWidgets.QWidget):
         self.freq_label.setText(f"{value} Hz")
 
     def on_amp_change(self, value):
-        self.amp_label.setText(f"{value} %")
+        self.amp_label.setText(f"{value} mVpp")
+
+    def on_offs_change(self, value):
+        self.offs_label.setText(f"{value} mV")
 
     def current_wave_str(self):
         if self.rb_sine.isChecked():
             return "SINE"
         if self.rb_tri.isChecked():
             return "TRI"
+        if self.rb_noise.isChecked():
+            return "NOISE"
+        if self.rb_multi.isChecked():
+            return "MULTI"
         return "SQR"
 
     def send_line(self, s):
@@ -363,18 +561,53 @@ class ScopeFuncGenRC(QtWidgets.QWidget):
     def send_start(self):
         f = self.freq_slider.value()
         a = self.amp_slider.value()
+        o = self.offs_slider.value()
+        d = 1 if self.cb_dither.isChecked() else 0
         w = self.current_wave_str()
-        cmd = f"FREQ:{f},AMP:{a},WAVE:{w},EN:1"
+        if w == "MULTI":
+            for line in tone_lines(self.tone_edit.text()):
+                self.send_line(line)
+        cmd = f"FREQ:{f},AMPMV:{a},OFFS:{o},DITH:{d},WAVE:{w},EN:1"
         self.send_line(cmd)
 
     def send_stop(self):
         self.send_line("EN:0")
 
+    def send_acq(self, *_):
+        src = "GEN" if self.cb_sync.isChecked() else "FREE"
+        run = 1 if self.cb_run.isChecked() else 0
+        self.send_line(f"RUN:{run},TRIG:{src},AVG:{self.avg_spin.value()},LEN:{self.len_spin.value()}")
+
+    def meas_cmd(self, kind):
+        n = self.shots_spin.value()
+        return f"MEAS:{kind}" if n == 1 else f"MEAS:{kind},N={n}"
+
     def send_meas_r(self):
-        self.send_line("MEAS:R")
+        self.send_line(self.meas_cmd("R"))
 
     def send_meas_c(self):
-        self.send_line("MEAS:C")
+        self.send_line(self.meas_cmd("C"))
+
+    def send_meas_d(self):
+        self.send_line(self.meas_cmd(f"D:{self.diode_spin.value()}"))
+
+    def send_stream(self, *_):
+        kind = self.stream_combo.currentText()
+        if self.meter_log:
+            self.meter_log.close()
+            self.meter_log = None
+        if kind == "Off":
+            self.send_line("METER:OFF")
+            return
+        path = time.strftime(f"meter_{kind}_%Y%m%d_%H%M%S.csv")
+        try:
+            self.meter_log = open(path, "w")
+            self.meter_log.write("host_time_s,seq,t_ms,kind,ok,range,value\n")
+            print(f"Logging meter stream to {path}")
+        except OSError as e:
+            print("Meter log open failed:", e)
+        self.meter_seq = None
+        self.send_line(f"METER:{kind}:{self.stream_spin.value()}")
 
     def quit_app(self):
         # close serial if open, then quit application
@@ -383,6 +616,8 @@ class ScopeFuncGenRC(QtWidgets.QWidget):
                 self.ser.close()
             except Exception:
                 pass
+        if self.meter_log:
+            self.meter_log.close()
         QtWidgets.QApplication.instance().quit()
 
     # ------------- Save waveform -------------
@@ -433,8 +668,13 @@ class ScopeFuncGenRC(QtWidgets.QWidget):
     def handle_byte(self, b):
         # frame state machine
         if self.frame_state == "idle":
-            if b == 0xAA:
-                self.frame_state = "len"
+            if b == FRAME_MARK:
+                self.pending_data = bytearray()
+                self.frame_state = "fhdr"
+            elif b == METER_MARK:
+                self.frame_state = "mlen"
+            elif b == LOG_MARK:
+                self.frame_state = "llen"
             else:
                 ch = chr(b)
                 if ch == '\r' or ch == '\n':
@@ -443,55 +683,382 @@ class ScopeFuncGenRC(QtWidgets.QWidget):
                         self.line_buf = ""
                 elif 32 <= b <= 126:
                     self.line_buf += ch
-        elif self.frame_state == "len":
-            self.pending_len = b
-            if self.pending_len == FRAME_SAMPLES:
+        elif self.frame_state == "fhdr":
+            self.pending_data.append(b)
+            if len(self.pending_data) >= FRAME_HDR.size:
+                rec_id, total, off, n = FRAME_HDR.unpack(bytes(self.pending_data))
+                if (REC_MIN_LEN <= total <= REC_MAX_LEN and 0 < n <= FRAME_CHUNK_MAX
+                        and off + n <= total):
+                    self.pending_hdr = (rec_id, total, off)
+                    self.pending_len = n
+                    self.pending_data = bytearray()
+                    self.frame_state = "data"
+                else:
+                    self.frame_state = "idle"
+        elif self.frame_state == "mlen":
+            if b == METER_REC.size:
                 self.pending_data = bytearray()
-                self.frame_state = "data"
+                self.frame_state = "mdata"
             else:
                 self.frame_state = "idle"
+        elif self.frame_state == "mdata":
+            self.pending_data.append(b)
+            if len(self.pending_data) >= METER_REC.size:
+                self.handle_meter_record(bytes(self.pending_data))
+                self.frame_state = "idle"
+        elif self.frame_state == "llen":
+            n = b - LOG_HDR.size
+            if 0 <= n <= 4 * LOG_MAX_ARGS and n % 4 == 0:
+                self.pending_len = b
+                self.pending_data = bytearray()
+                self.frame_state = "ldata"
+            else:
+                self.frame_state = "idle"
+        elif self.frame_state == "ldata":
+            self.pending_data.append(b)
+            if len(self.pending_data) >= self.pending_len:
+                self.handle_log_record(bytes(self.pending_data))
+                self.frame_state = "idle"
         elif self.frame_state == "data":
             self.pending_data.append(b)
             if len(self.pending_data) >= self.pending_len:
-                self.handle_frame(bytes(self.pending_data))
+                self.handle_chunk(*self.pending_hdr, bytes(self.pending_data))
                 self.frame_state = "idle"
 
     def handle_line(self, line):
-        if line.startswith("R_GND:"):
+        if line.startswith("R_RNG:"):
+            try:
+                self.r_range = int(line.split(":", 1)[1])
+            except ValueError:
+                self.r_range = None
+        elif line.startswith("R_GND:"):
             try:
                 r = int(line.split(":", 1)[1])
-                self.label_R.setText(f"R (Ω): {r}")
             except ValueError:
-                pass
+                return
+            rng = ""
+            if self.r_range is not None and self.r_range < len(R_RANGE_NAMES):
+                rng = f"  [{R_RANGE_NAMES[self.r_range]}]"
+            if r < 0:
+                self.label_R.setText("R (Ω): open")
+            else:
+                self.label_R.setText(f"R (Ω): {r}{rng}")
+        elif line.startswith("DIODE:"):
+            state, mv = (line.split(":", 1)[1].split(",") + ["0"])[:2]
+            text = {"FWD": f"Diode: Vf = {mv} mV",
+                    "RES": f"Not a diode (resistive, {mv} mV)",
+                    "SHORT": "Diode: short",
+                    "OPEN": "Diode: open or reversed"}.get(state, line)
+            self.label_X.setText(text)
+        elif line.startswith("CONT:"):
+            f = line.split(":", 1)[1].split(",")
+            if len(f) >= 3:
+                beep = "CLOSED" if f[0] == "1" else "open"
+                self.label_X.setText(f"Continuity: {beep} ({f[1]} Ω, {f[2]} µs)")
+        elif line.startswith("L_uH:"):
+            v = line.split(":", 1)[1]
+            msg = {"SMALL": "below range (< ~5 mH)", "LARGE": "above range",
+                   "NOPATH": "no DC path",
+                   "NOFIXTURE": "no fixture, fit 100 Ω across the R jacks"
+                   }.get(v, f"{v} µH")
+            self.label_X.setText(f"L: {msg}")
+        elif line.startswith("ALL:"):
+            # ohms (-1 open), R range, pF (-1 timeout), channel bits, scan us
+            try:
+                r, rng, c_pf, ch_ok, us = (int(v) for v in
+                                           line.split(":", 1)[1].split(",")[:5])
+            except ValueError:
+                return
+            if ch_ok & 1 and r >= 0:
+                name = R_RANGE_NAMES[rng] if rng < len(R_RANGE_NAMES) else "?"
+                self.label_R.setText(f"R (Ω): {r}  [{name}]")
+            else:
+                self.label_R.setText("R (Ω): open")
+            if ch_ok & 2 and c_pf >= 0:
+                self.label_C.setText(f"C (µF): {c_pf / 1e6:.6f}")
+            else:
+                self.label_C.setText("C (µF): timeout")
+            self.status_label.setText(f"Status: scan {us / 1000:.1f} ms")
+        elif line.startswith("CFIT:"):
+            # pF, leakage kohm (-1: none), residual per mille
+            f = line.split(":", 1)[1].split(",")
+            try:
+                c_pf, leak, fit = (int(v) for v in f[:3])
+            except ValueError:
+                return
+            if c_pf < 0:
+                self.label_C.setText("C (µF): fit failed")
+                return
+            self.label_C.setText(f"C (µF): {c_pf / 1e6:.6f}")
+            leak_txt = "none" if leak < 0 else f"{leak} kΩ"
+            self.status_label.setText(
+                f"Status: C fit, leakage {leak_txt}, residual {fit / 10:.1f} %")
+        elif "_STAT:" in line:
+            self.handle_stat(line)
         elif line.startswith("C_uF:"):
             try:
                 c = float(line.split(":", 1)[1])
                 self.label_C.setText(f"C (µF): {c:.3f}")
             except ValueError:
                 pass
+        elif line.startswith("CAL_SCOPE:"):
+            global CAL_GAIN
+            try:
+                CAL_GAIN = int(line.split(":", 1)[1]) / 1e6
+            except ValueError:
+                return
+            self.plot.setYRange(0, FULL_SCALE_V * CAL_GAIN)
+        elif line.startswith("CAL"):
+            # CAL_Rn/CAL_C coefficients, CAL:EEPROM/DEFAULT/ERR
+            print(line)
+            self.status_label.setText(f"Status: {line}")
+        elif line.startswith("GEN_CLIP:"):
+            n = line.split(":", 1)[1]
+            self.status_label.setText(f"Status: generator clipping ({n} pts)")
+        elif line.startswith("REC_LEN:"):
+            n = int(line.split(":", 1)[1])
+            if n != self.len_spin.value():
+                self.len_spin.blockSignals(True)
+                self.len_spin.setValue(n)
+                self.len_spin.blockSignals(False)
+            self.status_label.setText(f"Status: record {n} samples")
         elif line.startswith("READY"):
             self.status_label.setText("Status: READY")
-        elif line.startswith("DBG_"):
-            print(line)
+        elif line.startswith("STATS_"):
+            self.stats_lines.append(line)
+        elif line.startswith("STATS:END"):
+            text = format_stats(self.stats_lines)
+            self.stats_lines = []
+            print(text)
+            self.stats_view.setPlainText(text)
+            self.stats_view.show()
+            self.status_label.setText("Status: stats updated")
+        elif line.startswith("STATS:RESET"):
+            self.status_label.setText("Status: ISR stats reset")
+        elif line.startswith("JITTER_HIST:"):
+            text = format_jitter(self.jitter_line, line)
+            self.stats_view.setPlainText(text)
+            self.stats_view.show()
+            self.status_label.setText("Status: generator jitter updated")
+        elif line == "JITTER:BUSY":
+            self.status_label.setText("Status: jitter run already in progress")
+        elif line.startswith("JITTER:"):
+            self.jitter_line = line
+            if line == "JITTER:NONE":
+                self.status_label.setText("Status: generator off, start it to measure jitter")
         else:
             self.status_label.setText(f"Status: {line}")
 
+    def handle_meter_record(self, data):
+        kind, status, seq, t_ms, value = METER_REC.unpack(data)
+        ok = status & 1
+        rng = (status >> 1) & 3
+        kind_s = "C" if kind == 1 else "R"
+
+        if self.meter_seq is not None and seq != ((self.meter_seq + 1) & 0xFFFF):
+            lost = (seq - self.meter_seq - 1) & 0xFFFF
+            self.status_label.setText(f"Status: meter stream lost {lost}")
+        self.meter_seq = seq
+
+        if kind_s == "R":
+            self.label_R.setText(f"R (Ω): {value}  [{R_RANGE_NAMES[rng]}]"
+                                 if ok else "R (Ω): open")
+        else:
+            self.label_C.setText(f"C (µF): {value / 1e6:.6f}" if ok
+                                 else "C (µF): timeout")
+
+        if self.meter_log:
+            self.meter_log.write(f"{time.time():.3f},{seq},{t_ms},{kind_s},"
+                                 f"{ok},{rng},{value}\n")
+
+    def handle_log_record(self, data):
+        log_id, t_ms = LOG_HDR.unpack_from(data)
+        args = struct.unpack_from(f"<{(len(data) - LOG_HDR.size) // 4}i", data,
+                                  LOG_HDR.size)
+        if log_id < len(LOG_FORMATS):
+            try:
+                text = LOG_FORMATS[log_id][1] % args
+            except TypeError:
+                text = f"{LOG_FORMATS[log_id][0]} {args}"
+        else:
+            # firmware newer than log_table.py: re-run gen_log_table.py
+            text = f"LOG#{log_id} {args}"
+        print(f"[{t_ms} ms] {text}")
+
+    def handle_stat(self, line):
+        # <kind>_STAT:n=..,mean=..,sd=..,min=..,max=..,fail=..
+        # (ohms for R, pF for C/CFIT, mV for D/CONT, nH for L)
+        kind, body = line.split("_STAT:", 1)
+        try:
+            st = {k: int(v) for k, v in
+                  (f.split("=", 1) for f in body.split(","))}
+        except ValueError:
+            return
+        if st.get("n", 0) == 0:
+            self.status_label.setText(f"Status: {kind} batch failed")
+            return
+        if kind == "R":
+            self.label_R.setText(f"R (Ω): {st['mean']} ± {st['sd']}")
+        elif kind in ("C", "CFIT"):
+            self.label_C.setText(f"C (µF): {st['mean'] / 1e6:.6f} "
+                                 f"± {st['sd'] / 1e6:.6f}")
+        elif kind == "L":
+            self.label_X.setText(f"L (µH): {st['mean'] / 1e3:.1f} "
+                                 f"± {st['sd'] / 1e3:.1f}")
+        else:
+            self.label_X.setText(f"{kind} (mV): {st['mean']} ± {st['sd']}")
+        self.status_label.setText(
+            f"Status: {kind} n={st['n']} min={st['min']} max={st['max']} "
+            f"fail={st.get('fail', 0)}")
+
+    def handle_chunk(self, rec_id, total, off, data):
+        # chunks arrive in order; a gap means the firmware gave up on
+        # the record (TX behind or settings changed), so drop it
+        if off == 0:
+            self.rec = bytearray(data)
+            self.rec_id = rec_id
+            self.rec_total = total
+        elif (self.rec is None or rec_id != self.rec_id
+              or total != self.rec_total or off != len(self.rec)):
+            self.rec = None
+            return
+        else:
+            self.rec += data
+        if len(self.rec) >= self.rec_total:
+            rec, self.rec = bytes(self.rec), None
+            self.handle_frame(rec)
+        elif total > 4 * FRAME_CHUNK_MAX:
+            self.status_label.setText(f"Status: record {len(self.rec)}/{total}")
+
     def handle_frame(self, data):
         frame = np.frombuffer(data, dtype=np.uint8)
+        resized = self.last_frame is None or len(self.last_frame) != len(frame)
         self.last_frame = frame
 
-        aligned_v = trigger_align(frame, N_PLOT)
-        self.curve.setData(self.t, aligned_v)
+        if len(frame) > REC_DEFAULT_LEN:
+            # deep record: all of it, the view zooms
+            t = np.arange(len(frame)) / SAMPLE_RATE_HZ * 1000.0
+            self.curve.setData(t, adc_to_volts(frame))
+            if resized:
+                self.plot.setXRange(0, t[-1])
+        else:
+            if self.cb_sync.isChecked():
+                # firmware already started the frame on the generator wrap
+                aligned_v = fit_window(adc_to_volts(frame), N_PLOT)
+            else:
+                aligned_v = trigger_align(frame, N_PLOT)
+            self.curve.setData(self.t, aligned_v)
+            if resized:
+                self.plot.setXRange(0, TIME_WINDOW_S * 1000.0)
 
         freq, amp = estimate_freq_amp(frame)
         self.plot.setTitle(f"Freq: {freq:7.1f} Hz    Amp: {amp:5.3f} Vpp")
 
 
+# ---------- generator helpers ----------
+
+MAX_TONES = 8
+
+def tone_lines(text):
+    """ "1:100:0; 3:50:90" -> ["TONE:CLR", "TONE:0:1:100:0", "TONE:1:3:50:90"]
+    One command per line keeps each inside the firmware's 64-byte cmdBuf.
+    """
+    parts = ["TONE:CLR"]
+    specs = [p.strip() for p in text.split(";") if p.strip()]
+    for slot, spec in enumerate(specs[:MAX_TONES]):
+        fields = [f.strip() for f in spec.split(":")]
+        if len(fields) != 3 or not all(f.isdigit() for f in fields):
+            continue
+        parts.append(f"TONE:{slot}:{fields[0]}:{fields[1]}:{fields[2]}")
+    return parts
+
+
+# ---------- STATS report ----------
+
+def parse_stats_line(line):
+    """ "STATS_ISR:WAVE,n=10,min=80" -> ("ISR", "WAVE", {"n": "10", "min": "80"})
+    Lines without a leading name (FRAMES, UART, PWR) give name "";
+    TX lines are named by class (CTRL, MEAS, FRAME, DEBUG).
+    """
+    group, _, rest = line[len("STATS_"):].partition(":")
+    name, fields = "", {}
+    for part in rest.split(","):
+        k, eq, v = part.partition("=")
+        if eq:
+            fields[k] = v
+        else:
+            name = part
+    return group, name, fields
+
+
+def format_stats(lines):
+    cyc_per_us = 24.0     # BCLK, as CYCLES_PER_US in cpu_cycles.h
+    out = ["ISR        entries   min/avg/max us      load %"]
+    rest = []
+    tasks = []
+    for line in lines:
+        group, name, f = parse_stats_line(line)
+        if group == "ISR":
+            us = "/".join(f"{int(f.get(k, 0)) / cyc_per_us:.1f}"
+                          for k in ("min", "avg", "max"))
+            out.append(f"{name:<8} {f.get('n', '0'):>9}   {us:<18} {f.get('load_pct', '0'):>6}")
+        elif group == "TASK":
+            tasks.append(f"{name:<8} prio {f.get('prio', '?'):>2}  cpu {f.get('cpu_pct', '0'):>5} %"
+                         f"  stack free {f.get('stack_free', '?')} words")
+        else:
+            label = f"{group} {name}" if name else group
+            rest.append(f"{label:<14} " + "  ".join(f"{k}={v}" for k, v in f.items()))
+    if tasks:
+        out.append("")
+        out.append("tasks (share of awake time)")
+        out.extend(tasks)
+    if rest:
+        out.append("")
+        out.extend(rest)
+    return "\n".join(out)
+
+
+def format_jitter(summary, hist):
+    # JITTER:n=..,period=..,dev_min=..,dev_max=..,tie_pp=..,missed=..
+    # JITTER_HIST:bin=<cycles>,<count>/<count>/...   (cycles of BCLK)
+    ns_per_cyc = 1000.0 / 24.0
+    f = {}
+    for kv in summary.split(":", 1)[1].split(","):
+        if "=" in kv:
+            k, v = kv.split("=", 1)
+            f[k] = int(v)
+    head, counts = hist.split(":", 1)[1].split(",", 1)
+    width = int(head.split("=", 1)[1])
+    counts = [int(c) for c in counts.split("/")]
+    half = len(counts) // 2
+
+    out = [f"WaveTimer_ISR entry jitter, {f.get('n', 0)} intervals",
+           f"period      {f.get('period', 0) * ns_per_cyc / 1000.0:.3f} us",
+           f"interval    {f.get('dev_min', 0) * ns_per_cyc:+.0f} .. "
+           f"{f.get('dev_max', 0) * ns_per_cyc:+.0f} ns from the period",
+           f"phase p-p   {f.get('tie_pp', 0) * ns_per_cyc:.0f} ns   "
+           f"missed steps {f.get('missed', 0)}", ""]
+    peak = max(counts) or 1
+    for i, c in enumerate(counts):
+        lo = (i - half) * width * ns_per_cyc
+        edge = "<" if i == 0 else (">" if i == len(counts) - 1 else " ")
+        bar = "#" * int(round(40.0 * c / peak))
+        out.append(f"{edge}{lo:+7.0f} ns {c:>8}  {bar}".rstrip())
+    return "\n".join(out)
+
+
 # ---------- signal processing helpers ----------
 
 def adc_to_volts(arr):
     return (arr.astype(np.float32) / 255.0) * FULL_SCALE_V * CAL_GAIN
 
+def fit_window(vals_v, n_out):
+    if len(vals_v) >= n_out:
+        return vals_v[:n_out]
+    out = np.full(n_out, vals_v[-1], dtype=np.float32)
+    out[:len(vals_v)] = vals_v
+    return out
+
 def trigger_align(frame, n_out):
     vals_adc = frame.astype(np.float32)
     vals_v = adc_to_volts(frame)
@@ -545,6 +1112,9 @@ def estimate_freq_amp(frame):
 
 # ---------- main ----------
 if __name__ == "__main__":
+    # a port on the command line, e.g. the pty of the host build (fwsim)
+    if len(sys.argv) > 1:
+        PORT = sys.argv[1]
     app = QtWidgets.QApplication([])
     win = ScopeFuncGenRC()
     win.show()
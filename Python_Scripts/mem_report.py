@@ -0,0 +1,177 @@
+"""
+SRAM budget report from the GNU ld map file of the PSoC build.
+
+Every FreeRTOS object (task stacks and TCBs, queues, stream and message
+buffers) is statically allocated, so the map accounts for all of RAM:
+.data/.bss per object file, the newlib heap and the main (MSP) stack.
+Run it after a build and keep the output with the release.
+
+Usage:
+    python mem_report.py                    # Debug map of the project
+    python mem_report.py <project.map>
+    python mem_report.py <project.map> --min-free 4096   # exit 1 below that
+"""
+import os
+import re
+import sys
+
+DEFAULT_MAP = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                           "..", "Group_5_Project", "project.cydsn",
+                           "CortexM3", "ARM_GCC_541", "Debug", "project.map")
+
+TOP_OBJECTS = 12
+TOP_SYMBOLS = 15
+
+# output sections that are not per-object data
+RESERVED = {
+    ".heap":  "newlib malloc (CYDEV_HEAP_SIZE)",
+    ".stack": "main / ISR stack (CYDEV_STACK_SIZE)",
+}
+
+OUT_SECT = re.compile(r"^(\.[\w.]+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+IN_SECT = re.compile(r"^ (\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+IN_SECT_CONT = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+FILL = re.compile(r"^ \*fill\*\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+SYMBOL = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+([A-Za-z_]\w*)\s*$")
+MEM_REGION = re.compile(r"^(\w+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+
+
+# ---------------- parsing ----------------
+def object_name(path):
+    """ '.\\CortexM3\\...\\project.a(CyLib.o)' -> 'CyLib.o' """
+    path = path.strip().replace("\\", "/")
+    m = re.search(r"\(([^)]+)\)$", path)
+    if m:
+        return m.group(1)
+    return path.rsplit("/", 1)[-1]
+
+
+def ram_region(lines):
+    in_cfg = False
+    for line in lines:
+        if line.startswith("Memory Configuration"):
+            in_cfg = True
+            continue
+        if in_cfg:
+            m = MEM_REGION.match(line)
+            if m and m.group(1) == "ram":
+                return int(m.group(2), 16), int(m.group(3), 16)
+            if line.startswith("Linker script"):
+                break
+    raise ValueError("no 'ram' region in the map's Memory Configuration")
+
+
+def parse(lines):
+    origin, length = ram_region(lines)
+    in_ram = lambda a: origin <= a < origin + length
+
+    sections = {}      # output section -> (addr, size)
+    objects = {}       # object file -> bytes in RAM
+    symbols = []       # (addr, name, object, end of its input section)
+    fill = 0
+
+    cur_out = None
+    pending_out = None
+    pending_in = None
+    cur_in = None      # (object, end address)
+    for line in lines:
+        if line.startswith("."):
+            m = OUT_SECT.match(line)
+            if m:
+                cur_out = m.group(1)
+                sections[cur_out] = (int(m.group(2), 16), int(m.group(3), 16))
+            else:
+                pending_out = line.strip()
+            cur_in = None
+            continue
+        if pending_out:
+            m = IN_SECT_CONT.match(line)
+            if m:
+                cur_out = pending_out
+                sections[cur_out] = (int(m.group(1), 16), int(m.group(2), 16))
+            pending_out = None
+            continue
+
+        m = FILL.match(line)
+        if m:
+            if in_ram(int(m.group(1), 16)) and cur_out not in RESERVED:
+                fill += int(m.group(2), 16)
+            continue
+
+        m = IN_SECT.match(line)
+        addr = size = obj = None
+        if m:
+            addr, size, obj = int(m.group(2), 16), int(m.group(3), 16), m.group(4)
+        elif pending_in:
+            m = IN_SECT_CONT.match(line)
+            if m:
+                addr, size, obj = int(m.group(1), 16), int(m.group(2), 16), m.group(3)
+        pending_in = None
+        if addr is not None:
+            cur_in = None
+            if in_ram(addr) and size and cur_out not in RESERVED:
+                name = object_name(obj)
+                objects[name] = objects.get(name, 0) + size
+                cur_in = (name, addr + size)
+            continue
+        if re.match(r"^ [.\w]\S*\s*$", line) or line.startswith(" COMMON"):
+            pending_in = True
+            continue
+
+        m = SYMBOL.match(line)
+        if m and cur_in and in_ram(int(m.group(1), 16)):
+            symbols.append((int(m.group(1), 16), m.group(2), cur_in[0], cur_in[1]))
+
+    # global symbol sizes: up to the next symbol or the end of its section
+    sized = []
+    symbols.sort()
+    for i, (addr, name, obj, end) in enumerate(symbols):
+        nxt = symbols[i + 1][0] if i + 1 < len(symbols) else end
+        sized.append((min(nxt, end) - addr, name, obj))
+
+    ram = {k: v for k, v in sections.items() if in_ram(v[0]) and v[1]}
+    return origin, length, ram, objects, sized, fill
+
+
+# ---------------- report ----------------
+def report(path, min_free=None):
+    with open(path, errors="replace") as f:
+        lines = f.read().splitlines()
+    origin, length, ram, objects, symbols, fill = parse(lines)
+
+    # the stack sits at the top, so "used" is everything outside the gap
+    used = sum(size for _, size in ram.values())
+    free = length - used
+
+    out = [f"SRAM 0x{origin:08x}, {length} bytes", "",
+           f"{'section':<14}{'bytes':>8}"]
+    for name, (addr, size) in sorted(ram.items(), key=lambda kv: kv[1][0]):
+        note = RESERVED.get(name, "")
+        out.append(f"{name:<14}{size:>8}  {note}".rstrip())
+    out.append(f"{'used':<14}{used:>8}  ({100.0 * used / length:.1f} %)")
+    out.append(f"{'free':<14}{free:>8}")
+
+    out += ["", f"largest .data/.bss by object (alignment fill {fill} bytes)"]
+    for name, size in sorted(objects.items(), key=lambda kv: -kv[1])[:TOP_OBJECTS]:
+        out.append(f"  {name:<28}{size:>8}")
+
+    out += ["", "largest global symbols (file statics count under their object)"]
+    for size, name, obj in sorted(symbols, reverse=True)[:TOP_SYMBOLS]:
+        out.append(f"  {name:<28}{size:>8}  {obj}")
+
+    print("\n".join(out))
+    if min_free is not None and free < min_free:
+        print(f"\nFAIL: {free} bytes free, budget asks for {min_free}")
+        return 1
+    return 0
+
+
+# ---------------- main ----------------
+if __name__ == "__main__":
+    args = sys.argv[1:]
+    min_free = None
+    if "--min-free" in args:
+        i = args.index("--min-free")
+        min_free = int(args[i + 1], 0)
+        del args[i:i + 2]
+    sys.exit(report(args[0] if args else DEFAULT_MAP, min_free))